@@ -25,37 +25,56 @@ SOFTWARE.
 */
 #pragma once
 
+#include <limits.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
 #include <string>
 #include "imgui.h"
+#include "candy_fwd.h"
 #include "gradient.h"
 
+// Theme tables are built at compile time when C++14 relaxed constexpr is available, once at runtime otherwise
+#if __cplusplus >= 201402L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L)
+#define IMCANDY_CONSTEXPR14 constexpr
+#else
+#define IMCANDY_CONSTEXPR14
+#endif
+
 #ifdef IMCANDYCONSTS
+// ImVec4 has constexpr constructors since Dear ImGui 1.85, older versions get plain constants
+#if defined(IMGUI_VERSION_NUM) && IMGUI_VERSION_NUM >= 18500
+#define IMCANDY_IV4 constexpr ImVec4
+#else
+#define IMCANDY_IV4 static const ImVec4
+#endif
 //Hex to ImVec4 helper: https://heximv4.rs5709.repl.co
-const ImVec4 IV4_WHITE{1.000,1.000,1.000,1.000};//#ffffff
-const ImVec4 IV4_BLACK{0.000,0.000,0.000,1.000};//#000000
-const ImVec4 IV4_CRIMSON{0.827,0.063,0.153,1.000};//#D31027
-const ImVec4 IV4_SKYBLUE{0.125,0.741,1.000,1.000};//#20BDFF
-const ImVec4 IV4_AZURE{0.000,0.447,1.000,1.000};//#0072ff
-const ImVec4 IV4_HOTPINK{1.000,0.000,0.600,1.000};//#FF0099
-const ImVec4 IV4_CHARTREUSE{0.678,0.820,0.000,1.000};//#ADD100
-const ImVec4 IV4_EMERALD{0.220,0.937,0.490,1.000};//#38ef7d
-const ImVec4 IV4_BUBBLEGUM{0.988,0.404,0.980,1.000};//#fc67fa
-const ImVec4 IV4_TWITCH{0.569,0.275,1.000,1.000};//#9146FF
-const ImVec4 IV4_DISCORD{0.345,0.396,0.949,1.000};//#5865F2
-const ImVec4 IV4_TWITTER{0.114,0.631,0.949,1.000};//#1DA1F2
-const ImVec4 IV4_SPOTIFY{0.114,0.725,0.329,1.000};//#1DB954
-const ImVec4 IV4_GOOGLEBLUE{0.259,0.522,0.957,1.000};//#4285F4
-const ImVec4 IV4_MANGO{1.000,0.784,0.216,1.000};//#FFC837
-const ImVec4 IV4_VIOLET{0.584,0.000,1.000,1.000};//#9500ff
-const ImVec4 IV4_COSMICLATTE{1.000,0.973,0.906,1.000};//#fff8e7
-const ImVec4 IV4_TEAL{0.314,0.788,0.765,1.000};//#50C9C3
-const ImVec4 IV4_DRACULA{0.157,0.165,0.212,1.000};//#282a36
-const ImVec4 IV4_2077YELLOW{0.992,0.961,0.000,1.000};//#fdf500
-const ImVec4 IV4_CPNBLUE{0.000,0.878,1.000,1.0000};//#00e0ff
-const ImVec4 IV4_CPNVIOLET{0.612,0.000,1.000,1.000};//#9c00ff
-const ImVec4 IV4_CPNPURPLE{0.365,0.000,1.000,1.000};//#5d00ff
-const ImVec4 IV4_CPNDEEP{0.000,0.039,0.122,1.000};//#000a1f
+IMCANDY_IV4 IV4_WHITE{1.000,1.000,1.000,1.000};//#ffffff
+IMCANDY_IV4 IV4_BLACK{0.000,0.000,0.000,1.000};//#000000
+IMCANDY_IV4 IV4_CRIMSON{0.827,0.063,0.153,1.000};//#D31027
+IMCANDY_IV4 IV4_SKYBLUE{0.125,0.741,1.000,1.000};//#20BDFF
+IMCANDY_IV4 IV4_AZURE{0.000,0.447,1.000,1.000};//#0072ff
+IMCANDY_IV4 IV4_HOTPINK{1.000,0.000,0.600,1.000};//#FF0099
+IMCANDY_IV4 IV4_CHARTREUSE{0.678,0.820,0.000,1.000};//#ADD100
+IMCANDY_IV4 IV4_EMERALD{0.220,0.937,0.490,1.000};//#38ef7d
+IMCANDY_IV4 IV4_BUBBLEGUM{0.988,0.404,0.980,1.000};//#fc67fa
+IMCANDY_IV4 IV4_TWITCH{0.569,0.275,1.000,1.000};//#9146FF
+IMCANDY_IV4 IV4_DISCORD{0.345,0.396,0.949,1.000};//#5865F2
+IMCANDY_IV4 IV4_TWITTER{0.114,0.631,0.949,1.000};//#1DA1F2
+IMCANDY_IV4 IV4_SPOTIFY{0.114,0.725,0.329,1.000};//#1DB954
+IMCANDY_IV4 IV4_GOOGLEBLUE{0.259,0.522,0.957,1.000};//#4285F4
+IMCANDY_IV4 IV4_MANGO{1.000,0.784,0.216,1.000};//#FFC837
+IMCANDY_IV4 IV4_VIOLET{0.584,0.000,1.000,1.000};//#9500ff
+IMCANDY_IV4 IV4_COSMICLATTE{1.000,0.973,0.906,1.000};//#fff8e7
+IMCANDY_IV4 IV4_TEAL{0.314,0.788,0.765,1.000};//#50C9C3
+IMCANDY_IV4 IV4_DRACULA{0.157,0.165,0.212,1.000};//#282a36
+IMCANDY_IV4 IV4_2077YELLOW{0.992,0.961,0.000,1.000};//#fdf500
+IMCANDY_IV4 IV4_CPNBLUE{0.000,0.878,1.000,1.0000};//#00e0ff
+IMCANDY_IV4 IV4_CPNVIOLET{0.612,0.000,1.000,1.000};//#9c00ff
+IMCANDY_IV4 IV4_CPNPURPLE{0.365,0.000,1.000,1.000};//#5d00ff
+IMCANDY_IV4 IV4_CPNDEEP{0.000,0.039,0.122,1.000};//#000a1f
 #endif
 
 namespace ImCandy
@@ -72,294 +91,2357 @@ namespace ImCandy
 
       ImVec4 RainbowP(double step = 0.01);
 
-      ImVec4 Gradient2(ImVec4 col1, ImVec4 col2, double &static_ratio, double step = 0.01);
+      ImVec4 RainbowP(RainbowState &state, double step = 0.01);
+
+      void RainbowPalette(const RainbowState &state, ImU32* colors, int count);
 
-      ImVec4 Gradient3(ImVec4 col1, ImVec4 col2, ImVec4 col3, double &static_ratio, double step = 0.01);
+      ImVec4 Gradient2(ImVec4 col1, ImVec4 col2, double &static_ratio, double step = 0.01, gradient::ColorSpace space = gradient::ColorSpace::SRGB);
+
+      ImVec4 Gradient3(ImVec4 col1, ImVec4 col2, ImVec4 col3, double &static_ratio, double step = 0.01, gradient::ColorSpace space = gradient::ColorSpace::SRGB);
       */
 
-      // WARNING: High step values can cause unpleasant flashes
-      ImVec4 Rainbow(double &static_ratio, double step = 0.01)
+      /*
+      Persistent gradients: build once (e.g. as a static or a member), evaluate every frame.
+      Evaluation never touches the heap.
+      ---------------------------------------------------------------
+        static const ImCandy::Gradient<3> grad = {{ IV4_VIOLET, IV4_BUBBLEGUM, IV4_VIOLET }};
+        static double s0 = 0.0;
+        ImGui::PushStyleColor(ImGuiCol_Border, grad.Step(s0));
+      ---------------------------------------------------------------
+      */
+
+      // N evenly spaced stops at 0, 1, ..., N-1
+      template<int N>
+      struct Gradient
       {
-          step *= 6; //just to be linear with RainbowP
+          static_assert(N >= 2, "a gradient needs at least two stops");
+
+          ImVec4 Stops[N];
+
+          // Ratio is in [0, N-1], values outside are clamped to the end stops
+          constexpr ImVec4 Evaluate(double ratio) const
+          {
+              return ratio <= 0.0 ? Stops[0]
+                   : ratio >= N - 1 ? Stops[N - 1]
+                   : Lerp(int(ratio), float(ratio - int(ratio)));
+          }
 
-          gradient::LinearColorGradient gradient;
-          gradient[0.0] = {255,0,0};
-          gradient[1.0] = {255,255,0};
-          gradient[2.0] = {0,255,0};
-          gradient[3.0] = {0,255,255};
-          gradient[4.0] = {0,0,255};
-          gradient[5.0] = {255,0,255};
-          gradient[6.0] = {255,0,0};
+          // Color at ratio r in [0, 1] of the segment between Stops[i] and Stops[i + 1]
+          constexpr ImVec4 Lerp(int i, float r) const
+          {
+              return ImVec4(Stops[i + 1].x * r + Stops[i].x * (1.0f - r),
+                            Stops[i + 1].y * r + Stops[i].y * (1.0f - r),
+                            Stops[i + 1].z * r + Stops[i].z * (1.0f - r),
+                            Stops[i + 1].w * r + Stops[i].w * (1.0f - r));
+          }
 
-          double r, g, b = 0;
+          // Returns the current color, then advances static_ratio and wraps it at the last stop
+          ImVec4 Step(double &static_ratio, double step = 0.01) const
+          {
+              ImVec4 color = Evaluate(static_ratio);
 
-          auto color = gradient(static_ratio);
-          r = color[0];
-          g = color[1];
-          b = color[2];
+              static_ratio += step;
+              if (static_ratio >= N - 1)
+                  static_ratio = 0.0;
 
-          static_ratio += step;
-          if (static_ratio >= 6.0)
-              static_ratio = 0.0;
+              return color;
+          }
+      };
+
+      struct RainbowGradient : Gradient<7>
+      {
+          constexpr RainbowGradient() : Gradient<7>{{
+              ImVec4(1.0f, 0.0f, 0.0f, 1.0f),
+              ImVec4(1.0f, 1.0f, 0.0f, 1.0f),
+              ImVec4(0.0f, 1.0f, 0.0f, 1.0f),
+              ImVec4(0.0f, 1.0f, 1.0f, 1.0f),
+              ImVec4(0.0f, 0.0f, 1.0f, 1.0f),
+              ImVec4(1.0f, 0.0f, 1.0f, 1.0f),
+              ImVec4(1.0f, 0.0f, 0.0f, 1.0f) }} {}
+      };
+
+      // Compile-time table of packed colors, e.g. a rainbow LUT that lives in .rodata:
+      //   static constexpr ImCandy::GradientTable<1024> lut = ImCandy::MakeTable<1024>(ImCandy::RainbowGradient());
+      template<int Resolution>
+      struct GradientTable
+      {
+          ImU32 Colors[Resolution];
+          double LastKey;
+
+          // Nearest entry, ratio is in [0, LastKey]
+          constexpr ImU32 Sample(double ratio) const
+          {
+              return ratio <= 0.0 ? Colors[0]
+                   : ratio >= LastKey ? Colors[Resolution - 1]
+                   : Colors[int(ratio * (Resolution - 1) / LastKey + 0.5)];
+          }
+      };
+
+      namespace detail
+      {
+          template<int... I> struct IndexSequence {};
 
-          return ImVec4(r / 255.0, g / 255.0, b / 255.0, 1.0);
+          template<typename A, typename B> struct ConcatSequence;
+          template<int... A, int... B> struct ConcatSequence<IndexSequence<A...>, IndexSequence<B...>> { typedef IndexSequence<A..., (int(sizeof...(A)) + B)...> Type; };
+
+          // Logarithmic depth, so 4096-entry tables stay well under the template recursion limits
+          template<int N> struct MakeIndexSequence { typedef typename ConcatSequence<typename MakeIndexSequence<N / 2>::Type, typename MakeIndexSequence<N - N / 2>::Type>::Type Type; };
+          template<> struct MakeIndexSequence<0> { typedef IndexSequence<> Type; };
+          template<> struct MakeIndexSequence<1> { typedef IndexSequence<0> Type; };
+
+          constexpr ImU32 ToByte(float v) { return ImU32((v < 0.0f ? 0.0f : v > 1.0f ? 1.0f : v) * 255.0f + 0.5f); }
+
+          // Same rounding as ImGui::ColorConvertFloat4ToU32
+          constexpr ImU32 PackColor(const ImVec4& c) { return IM_COL32(ToByte(c.x), ToByte(c.y), ToByte(c.z), ToByte(c.w)); }
+
+          template<int Resolution, int N, int... I>
+          constexpr GradientTable<Resolution> MakeTable(const Gradient<N>& gradient, IndexSequence<I...>)
+          {
+              return GradientTable<Resolution>{ { PackColor(gradient.Evaluate(double(I) * (N - 1) / (Resolution - 1)))... }, double(N - 1) };
+          }
+      }
+
+      template<int Resolution, int N>
+      constexpr GradientTable<Resolution> MakeTable(const Gradient<N>& gradient)
+      {
+          return detail::MakeTable<Resolution>(gradient, typename detail::MakeIndexSequence<Resolution>::Type());
       }
 
+      // WARNING: High step values can cause unpleasant flashes
+      IMCANDY_API ImVec4 Rainbow(double &static_ratio, double step = 0.01);
+
+      // State of RainbowP(), one per independent animation or thread
+      struct RainbowState
+      {
+          double Ratio = 0.0;         // Hue, in turns
+          float Saturation = 1.0f;
+          float Value = 1.0f;
+      };
+
+      // Portable version, reentrant: all state lives in 'state'. Integer HSV, see gradient::hsv8_to_rgba8()
+      IMCANDY_API ImVec4 RainbowP(RainbowState &state, double step = 0.01);
+
       // Portable version
-      ImVec4 RainbowP(double step = 0.01)
+      IMCANDY_API ImVec4 RainbowP(double step = 0.01);
+
+      // 'count' colors evenly spaced around the wheel from state.Ratio, in one batch. state is not advanced.
+      IMCANDY_API void RainbowPalette(const RainbowState &state, ImU32* colors, int count);
+
+      /*
+      Perceptual gradients: stops are converted once into linear sRGB or OKLab, which avoids the dark,
+      muddy midpoints of blending gamma-encoded colors (e.g. red to green through brown).
+      ---------------------------------------------------------------
+        static const ImCandy::PerceptualGradient<3> grad({{ IV4_VIOLET, IV4_BUBBLEGUM, IV4_VIOLET }});
+        static double s0 = 0.0;
+        ImGui::PushStyleColor(ImGuiCol_Border, grad.Step(s0));
+      ---------------------------------------------------------------
+      */
+
+      template<int N>
+      struct PerceptualGradient
+      {
+          Gradient<N> Stops; // in Space
+          gradient::ColorSpace Space;
+
+          PerceptualGradient(const Gradient<N>& srgb, gradient::ColorSpace space = gradient::ColorSpace::OKLab)
+              : Stops(srgb), Space(space)
+          {
+              for (int i = 0; i < N; i++)
+                  Stops.Stops[i] = FromColor4(gradient::to_color_space(ToColor4(srgb.Stops[i]), space));
+          }
+
+          // Ratio is in [0, N-1], the result is sRGB
+          ImVec4 Evaluate(double ratio) const
+          {
+              return FromColor4(gradient::from_color_space(ToColor4(Stops.Evaluate(ratio)), Space));
+          }
+
+          ImVec4 Step(double &static_ratio, double step = 0.01) const
+          {
+              ImVec4 color = Evaluate(static_ratio);
+
+              static_ratio += step;
+              if (static_ratio >= N - 1)
+                  static_ratio = 0.0;
+
+              return color;
+          }
+
+      private:
+          static gradient::Color4 ToColor4(const ImVec4& col) { return gradient::Color4{ col.x, col.y, col.z, col.w }; }
+          static ImVec4 FromColor4(const gradient::Color4& col) { return ImVec4(col.r, col.g, col.b, col.a); }
+      };
+
+      // Find some cool gradients from uigradients.com
+      IMCANDY_API ImVec4 Gradient2(ImVec4 col1, ImVec4 col2, double &static_ratio, double step = 0.01, gradient::ColorSpace space = gradient::ColorSpace::SRGB);
+
+      // Find some cool gradients from uigradients.com
+      IMCANDY_API ImVec4 Gradient3(ImVec4 col1, ImVec4 col2, ImVec4 col3, double &static_ratio, double step = 0.01, gradient::ColorSpace space = gradient::ColorSpace::SRGB);
+
+      // gradient::Color4 has the layout of ImVec4, so gradient.h gradients can work in ImGui's float space
+      inline ImVec4 ToImVec4(const gradient::Color4& col) { return ImVec4(col.r, col.g, col.b, col.a); }
+      inline gradient::Color4 ToColor4(const ImVec4& col) { return gradient::Color4{ col.x, col.y, col.z, col.w }; }
+
+      namespace detail
       {
-          static double static_ratio = 0.0;
+          // The last stop sets Gradient2()/Gradient3() were called with in another color space, converted once.
+          // Per thread, so the immediate-mode helpers stay safe to call from workers.
+          template<int N>
+          struct PerceptualStopCache
+          {
+              static const int Size = 8;
 
-          int normalized = int(static_ratio * 256 * 6);
+              struct Entry
+              {
+                  Gradient<N> Srgb;
+                  gradient::ColorSpace Space;
+                  Gradient<N> Stops;
+              };
 
-          int region = normalized / 256;
+              Entry Entries[Size];
+              int Count = 0;
+              int Next = 0;
 
-          int x = normalized % 256;
+              const Gradient<N>& Find(const Gradient<N>& srgb, gradient::ColorSpace space)
+              {
+                  for (int i = 0; i < Count; i++)
+                      if (Entries[i].Space == space && memcmp(Entries[i].Srgb.Stops, srgb.Stops, sizeof(srgb.Stops)) == 0)
+                          return Entries[i].Stops;
 
-          int r = 0, g = 0, b = 0;
-          switch (region)
+                  Entry& entry = Entries[Next];
+                  Next = (Next + 1) % Size;
+                  Count = Count < Size ? Count + 1 : Size;
+                  entry.Srgb = srgb;
+                  entry.Space = space;
+                  for (int i = 0; i < N; i++)
+                      entry.Stops.Stops[i] = ToImVec4(gradient::to_color_space(ToColor4(srgb.Stops[i]), space));
+                  return entry.Stops;
+              }
+          };
+
+          // PerceptualGradient<N>(srgb, space).Step() with the stops converted on the first call only:
+          // afterwards a call is one lerp plus the conversion back to sRGB
+          template<int N>
+          ImVec4 StepInSpace(const Gradient<N>& srgb, double &static_ratio, double step, gradient::ColorSpace space)
           {
-          case 0: r = 255; g = 0;   b = 0;   g += x; break;
-          case 1: r = 255; g = 255; b = 0;   r -= x; break;
-          case 2: r = 0;   g = 255; b = 0;   b += x; break;
-          case 3: r = 0;   g = 255; b = 255; g -= x; break;
-          case 4: r = 0;   g = 0;   b = 255; r += x; break;
-          case 5: r = 255; g = 0;   b = 255; b -= x; break;
+              static thread_local PerceptualStopCache<N> cache;
+              const Gradient<N>& stops = cache.Find(srgb, space);
+              const ImVec4 mixed = stops.Evaluate(static_ratio);
+
+              static_ratio += step;
+              if (static_ratio >= N - 1)
+                  static_ratio = 0.0;
+
+              return ToImVec4(gradient::from_color_space(ToColor4(mixed), space));
           }
+      }
+
+      // Same contract as Gradient<N>::Step() for a Color4 gradient from gradient.h (e.g. FlatLinearColor4Gradient),
+      // static_ratio wraps from its last key back to its first one
+      template<typename ColorGradient>
+      ImVec4 Step(const ColorGradient& gradient, double &static_ratio, double step = 0.01)
+      {
+          ImVec4 color = ToImVec4(gradient(static_ratio));
 
           static_ratio += step;
-          if (static_ratio >= 1.0)
-              static_ratio = 0.0;
+          if (static_ratio >= gradient.lastKey())
+              static_ratio = gradient.firstKey();
 
-          return ImVec4(r / 255.0, g / 255.0, b / 255.0, 1.0);
+          return color;
       }
 
-      // Find some cool gradients from uigradients.com
-      ImVec4 Gradient2(ImVec4 col1, ImVec4 col2, double &static_ratio, double step = 0.01)
+      /*
+      Baked gradients: sample a gradient once into a table of packed ImU32 colors, then every lookup is a
+      single indexed load (or a blend of two entries). Works for Gradient<N> and for any gradient from
+      gradient.h, including custom interpolation curves. The table keeps the gradient.h layout (R in the
+      low byte) whatever IM_COL32_R_SHIFT is, Step() returns IM_COL32 colors.
+      ---------------------------------------------------------------
+        static const gradient::BakedGradient<> baked = ImCandy::Bake(ImCandy::Gradient<3>{{ IV4_VIOLET, IV4_BUBBLEGUM, IV4_VIOLET }}, 1024);
+        static double s0 = 0.0;
+        draw_list->AddRectFilled(p_min, p_max, ImCandy::Step(baked, s0));
+      ---------------------------------------------------------------
+      */
+
+      template<int N>
+      gradient::BakedGradient<> Bake(const Gradient<N>& source, int resolution = 256)
       {
-          std::valarray<double> col1a(3);
-          col1a[0] = col1.x * 255.0;
-          col1a[1] = col1.y * 255.0;
-          col1a[2] = col1.z * 255.0;
-          std::valarray<double> col2a(3);
-          col2a[0] = col2.x * 255.0;
-          col2a[1] = col2.y * 255.0;
-          col2a[2] = col2.z * 255.0;
+          struct Sampler
+          {
+              const Gradient<N>& gradient;
+              void evaluate(const double* points, std::size_t count, ImU32* packed) const
+              {
+                  for (std::size_t i = 0; i < count; i++)
+                  {
+                      // Same layout as the gradient.h tables: R in the low byte
+                      const ImVec4 c = gradient.Evaluate(points[i]);
+                      packed[i] = detail::ToByte(c.x) | (detail::ToByte(c.y) << 8) | (detail::ToByte(c.z) << 16) | (detail::ToByte(c.w) << 24);
+                  }
+              }
+          };
 
-          gradient::LinearColorGradient gradient;
-          gradient[0.0] = col1a;
-          gradient[1.0] = col2a;
-          gradient[2.0] = col1a;
+          gradient::BakedGradient<> baked;
+          baked.bake(Sampler{source}, 0.0, double(N - 1), std::size_t(resolution));
+          return baked;
+      }
 
-          double r, g, b = 0;
+      // Same contract as Gradient<N>::Step(): returns the current color, then advances static_ratio
+      IMCANDY_API ImU32 Step(const gradient::BakedGradient<>& baked, double &static_ratio, double step = 0.01, bool interpolate = true);
 
-          auto color = gradient(static_ratio);
-          r = color[0];
-          g = color[1];
-          b = color[2];
+      // Rainbow() read from a 1024-entry table computed at compile time
+      IMCANDY_API ImU32 RainbowU32(double &static_ratio, double step = 0.01);
 
-          static_ratio += step;
-          if (static_ratio >= 2.0)
-              static_ratio = 0.0;
+      /*---------------------------------------------------------------------------------------------------------
+                                                        DRAWING                                                */
+
+      /*
+      Gradient fills for ImDrawList, from a Gradient<N> or any gradient.h gradient (e.g. FlatLinearColor4Gradient,
+      ColorSpaceGradient). Each call reserves its vertices and indices with a single PrimReserve() and emits one
+      vertex pair per stop, so a thousand gradient rows stay in the same draw command. The stops are flattened
+      once per call and shared by all strips: nothing is allocated for a Gradient<N>, a Color4 flat gradient or
+      up to 16 stops, larger gradients allocate that one copy per call.
+      Colors are interpolated linearly between vertices, so segments with another curve (cosine, custom,
+      OKLab, ...) are split in 'segments' pieces, 8 when left at 0.
+      ---------------------------------------------------------------
+        static const ImCandy::Gradient<3> grad = {{ IV4_VIOLET, IV4_BUBBLEGUM, IV4_VIOLET }};
+        ImDrawList* draw_list = ImGui::GetWindowDrawList();
+        ImCandy::DrawGradientRect(draw_list, p_min, p_max, grad);
+        ImCandy::DrawGradientBorder(draw_list, p_min, p_max, grad, 2.0f);
+      ---------------------------------------------------------------
+      */
+
+      namespace detail
+      {
+          // Common interface of Gradient<N> and the gradient.h gradients, keys are passed around as doubles
+          // except for evaluation, which takes the gradient's own key type
+          template<typename G> struct KeyType { typedef typename G::key_type Type; };
+          template<int N> struct KeyType<Gradient<N>> { typedef double Type; };
+
+          // Flattened stops shared by the EvaluateColors() calls of one draw or bake, Gradient<N> needs none
+          template<typename G> struct ScratchType { typedef gradient::BatchScratch<typename G::key_type> Type; };
+          template<int N> struct ScratchType<Gradient<N>> { struct Type {}; };
+
+          template<int N> int KeyCount(const Gradient<N>&) { return N; }
+          template<int N> double FirstKey(const Gradient<N>&) { return 0.0; }
+          template<int N> double LastKey(const Gradient<N>&) { return double(N - 1); }
+          template<int N> bool IsLinear(const Gradient<N>&) { return true; }
+          template<int N, typename Visitor> void ForEachKey(const Gradient<N>&, Visitor visit) { for (int i = 0; i < N; i++) visit(double(i)); }
+
+          template<int N>
+          void EvaluateColors(const Gradient<N>& source, const double* points, int count, ImU32* out, typename ScratchType<Gradient<N>>::Type&)
+          {
+              for (int i = 0; i < count; i++)
+                  out[i] = PackColor(source.Evaluate(points[i]));
+          }
+
+          template<typename G> int KeyCount(const G& source) { return int(source.size()); }
+          template<typename G> double FirstKey(const G& source) { return double(source.firstKey()); }
+          template<typename G> double LastKey(const G& source) { return double(source.lastKey()); }
+          template<typename G> bool IsLinear(const G& source) { return source.curveKind() == gradient::detail::Ease::Linear; }
+          template<typename G> bool IsLinear(const gradient::ColorSpaceGradient<G>& source) { return source.colorSpace() == gradient::ColorSpace::SRGB && IsLinear(source.base()); }
+          template<typename G, typename Visitor> void ForEachKey(const G& source, Visitor visit) { source.forEachKey(visit); }
+
+          template<typename G>
+          void EvaluateColors(const G& source, const typename G::key_type* points, int count, ImU32* out, typename ScratchType<G>::Type& scratch)
+          {
+              source.evaluate(points, std::size_t(count), out, scratch);
+#if IM_COL32_R_SHIFT != 0
+              // gradient.h packs R in the low byte
+              for (int i = 0; i < count; i++)
+                  out[i] = (out[i] & 0xFF00FF00) | ((out[i] & 0xFF) << 16) | ((out[i] >> 16) & 0xFF);
+#endif
+          }
+
+          // Quad strip between the edges A0-A1 and B0-B1, colored with the keys Lo..Hi along the edges
+          struct GradientStrip
+          {
+              ImVec2 A0, A1, B0, B1;
+              double Lo, Hi;
+          };
+
+          // Vertex pairs of a strip: both ends and every key in between, each segment split in 'segments' pieces
+          template<typename G>
+          int CountStripPairs(const G& source, const GradientStrip& strip, int segments)
+          {
+              int breakpoints = 2;
+              ForEachKey(source, [&](double key) { if (key > strip.Lo && key < strip.Hi) breakpoints++; });
+              return 1 + (breakpoints - 1) * segments;
+          }
+
+          // Buffers positions along the strip (0-1) with their keys and writes them in blocks once PrimReserve() has been called
+          template<typename G>
+          struct StripWriter
+          {
+              ImDrawList* DrawList;
+              const G& Source;
+              typename ScratchType<G>::Type& Scratch;
+              GradientStrip Strip;
+              int Segments;
+              float Positions[gradient::detail::batch_block];
+              typename KeyType<G>::Type Keys[gradient::detail::batch_block];
+              int Count;
+              int Written;
+              float Previous;
+
+              StripWriter(ImDrawList* draw_list, const G& source, typename ScratchType<G>::Type& scratch, const GradientStrip& strip, int segments)
+                  : DrawList(draw_list), Source(source), Scratch(scratch), Strip(strip), Segments(segments), Count(0), Written(0), Previous(0.0f) {}
+
+              void Write()
+              {
+                  const double range = Strip.Hi - Strip.Lo;
+                  Breakpoint(0.0f);
+                  ForEachKey(Source, [&](double key) { if (key > Strip.Lo && key < Strip.Hi) Breakpoint(float((key - Strip.Lo) / range)); });
+                  Breakpoint(1.0f);
+                  Flush();
+              }
+
+              void Breakpoint(float s)
+              {
+                  if (Written + Count > 0)
+                      for (int i = 1; i < Segments; i++)
+                          Push(Previous + (s - Previous) * float(i) / float(Segments));
+                  Push(s);
+                  Previous = s;
+              }
+
+              void Push(float s)
+              {
+                  Positions[Count] = s;
+                  Keys[Count++] = typename KeyType<G>::Type(Strip.Lo + (Strip.Hi - Strip.Lo) * s);
+                  if (Count == gradient::detail::batch_block)
+                      Flush();
+              }
+
+              void Flush()
+              {
+                  const int count = Count;
+                  if (count == 0)
+                      return;
+
+                  ImU32 colors[gradient::detail::batch_block];
+                  EvaluateColors(Source, Keys, count, colors, Scratch);
+
+                  const ImVec2 uv = DrawList->_Data->TexUvWhitePixel;
+                  for (int i = 0; i < count; i++, Written++)
+                  {
+                      const float s = Positions[i];
+                      const ImDrawIdx idx = (ImDrawIdx)DrawList->_VtxCurrentIdx;
+                      if (Written > 0)
+                      {
+                          DrawList->PrimWriteIdx((ImDrawIdx)(idx - 2)); DrawList->PrimWriteIdx(idx); DrawList->PrimWriteIdx((ImDrawIdx)(idx + 1));
+                          DrawList->PrimWriteIdx((ImDrawIdx)(idx - 2)); DrawList->PrimWriteIdx((ImDrawIdx)(idx + 1)); DrawList->PrimWriteIdx((ImDrawIdx)(idx - 1));
+                      }
+                      DrawList->PrimWriteVtx(ImVec2(Strip.A0.x + (Strip.A1.x - Strip.A0.x) * s, Strip.A0.y + (Strip.A1.y - Strip.A0.y) * s), uv, colors[i]);
+                      DrawList->PrimWriteVtx(ImVec2(Strip.B0.x + (Strip.B1.x - Strip.B0.x) * s, Strip.B0.y + (Strip.B1.y - Strip.B0.y) * s), uv, colors[i]);
+                  }
+                  Count = 0;
+              }
+          };
+
+          template<typename G>
+          void DrawStrips(ImDrawList* draw_list, const G& source, const GradientStrip* strips, int strip_count, int segments)
+          {
+              if (segments <= 0)
+                  segments = IsLinear(source) ? 1 : 8;
+
+              int pairs = 0;
+              for (int n = 0; n < strip_count; n++)
+                  pairs += CountStripPairs(source, strips[n], segments);
+              IMCANDY_METRICS_SCOPE(Draw, pairs * 2);
+
+              draw_list->PrimReserve((pairs - strip_count) * 6, pairs * 2);
+              typename ScratchType<G>::Type scratch;
+              for (int n = 0; n < strip_count; n++)
+                  StripWriter<G>(draw_list, source, scratch, strips[n], segments).Write();
+          }
+      }
+
+      // Fills [p_min, p_max] with the whole gradient, left to right (or top to bottom)
+      template<typename G>
+      void DrawGradientRect(ImDrawList* draw_list, const ImVec2& p_min, const ImVec2& p_max, const G& gradient, bool vertical = false, int segments = 0)
+      {
+          if (detail::KeyCount(gradient) == 0)
+              return;
 
-          return ImVec4(r / 255.0, g / 255.0, b / 255.0, 1.0);
+          const double lo = detail::FirstKey(gradient), hi = detail::LastKey(gradient);
+          const detail::GradientStrip strip = vertical
+              ? detail::GradientStrip{ p_min, ImVec2(p_min.x, p_max.y), ImVec2(p_max.x, p_min.y), p_max, lo, hi }
+              : detail::GradientStrip{ p_min, ImVec2(p_max.x, p_min.y), ImVec2(p_min.x, p_max.y), p_max, lo, hi };
+          detail::DrawStrips(draw_list, gradient, &strip, 1, segments);
       }
 
-      // Find some cool gradients from uigradients.com
-      ImVec4 Gradient3(ImVec4 col1, ImVec4 col2, ImVec4 col3, double &static_ratio, double step = 0.01)
-      {
-          std::valarray<double> col1a(3);
-          col1a[0] = col1.x * 255.0;
-          col1a[1] = col1.y * 255.0;
-          col1a[2] = col1.z * 255.0;
-          std::valarray<double> col2a(3);
-          col2a[0] = col2.x * 255.0;
-          col2a[1] = col2.y * 255.0;
-          col2a[2] = col2.z * 255.0;
-          std::valarray<double> col3a(3);
-          col3a[0] = col3.x * 255.0;
-          col3a[1] = col3.y * 255.0;
-          col3a[2] = col3.z * 255.0;
-
-
-          gradient::LinearColorGradient gradient;
-          gradient[0.0] = col1a;
-          gradient[1.0] = col2a;
-          gradient[2.0] = col3a;
-          gradient[3.0] = col1a;
-
-          double r, g, b = 0;
-
-          auto color = gradient(static_ratio);
-          r = color[0];
-          g = color[1];
-          b = color[2];
+      // Line from p1 (first key) to p2 (last key)
+      template<typename G>
+      void DrawGradientLine(ImDrawList* draw_list, const ImVec2& p1, const ImVec2& p2, const G& gradient, float thickness = 1.0f, int segments = 0)
+      {
+          const float dx = p2.x - p1.x, dy = p2.y - p1.y;
+          const float length = sqrtf(dx * dx + dy * dy);
+          if (detail::KeyCount(gradient) == 0 || length <= 0.0f)
+              return;
 
-          static_ratio += step;
-          if (static_ratio >= 3.0)
-              static_ratio = 0.0;
+          const ImVec2 n(-dy / length * thickness * 0.5f, dx / length * thickness * 0.5f);
+          const detail::GradientStrip strip = { ImVec2(p1.x + n.x, p1.y + n.y), ImVec2(p2.x + n.x, p2.y + n.y),
+                                                ImVec2(p1.x - n.x, p1.y - n.y), ImVec2(p2.x - n.x, p2.y - n.y),
+                                                detail::FirstKey(gradient), detail::LastKey(gradient) };
+          detail::DrawStrips(draw_list, gradient, &strip, 1, segments);
+      }
+
+      // Border drawn inside [p_min, p_max], the gradient runs once around it clockwise from the top-left corner
+      template<typename G>
+      void DrawGradientBorder(ImDrawList* draw_list, const ImVec2& p_min, const ImVec2& p_max, const G& gradient, float thickness = 1.0f, int segments = 0)
+      {
+          const float w = p_max.x - p_min.x, h = p_max.y - p_min.y;
+          if (detail::KeyCount(gradient) == 0 || w <= 0.0f || h <= 0.0f)
+              return;
+
+          const float t = std::min(thickness, std::min(w, h) * 0.5f);
+          const ImVec2 outer[4] = { p_min, ImVec2(p_max.x, p_min.y), p_max, ImVec2(p_min.x, p_max.y) };
+          const ImVec2 inner[4] = { ImVec2(p_min.x + t, p_min.y + t), ImVec2(p_max.x - t, p_min.y + t),
+                                    ImVec2(p_max.x - t, p_max.y - t), ImVec2(p_min.x + t, p_max.y - t) };
 
-          return ImVec4(r / 255.0, g / 255.0, b / 255.0, 1.0);
+          // Keys are spread over the outer perimeter
+          const double lo = detail::FirstKey(gradient), hi = detail::LastKey(gradient);
+          const double perimeter = 2.0 * (double(w) + double(h));
+          const double corners[5] = { 0.0, w, double(w) + h, 2.0 * w + h, perimeter };
+
+          detail::GradientStrip strips[4];
+          for (int i = 0; i < 4; i++)
+              strips[i] = detail::GradientStrip{ outer[i], outer[(i + 1) % 4], inner[i], inner[(i + 1) % 4],
+                                                 lo + (hi - lo) * corners[i] / perimeter, lo + (hi - lo) * corners[i + 1] / perimeter };
+          detail::DrawStrips(draw_list, gradient, strips, 4, segments);
       }
 
       /*---------------------------------------------------------------------------------------------------------
-                                                        THEMES                                                 */
+                                                       COLORMAPS                                               */
+
+      /*
+      Scalar fields (float, ImU16 or ImU8) to RGBA8 pixels through a 256-entry table, ready for texture upload.
+      The gradient is baked once, mapping a value is a multiply, a clamp and a load.
+      ColormapImage keeps the pixels of a whole field and the rectangle changed since the last upload.
+      ---------------------------------------------------------------
+        static ImCandy::ColormapImage heatmap(1024, 1024);
+        heatmap.Map = ImCandy::Colormap::Viridis();
+        heatmap.Map.SetRange(0.0f, 250.0f);
+        heatmap.Update(latency, 1024, x, y, w, h); // only the cells that changed
+
+        int rx, ry, rw, rh;
+        if (heatmap.GetDirtyRect(&rx, &ry, &rw, &rh))
+        {
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, heatmap.GetWidth());
+            glTexSubImage2D(GL_TEXTURE_2D, 0, rx, ry, rw, rh, GL_RGBA, GL_UNSIGNED_BYTE, heatmap.GetPixels(rx, ry));
+            heatmap.ClearDirty();
+        }
+      ---------------------------------------------------------------
+      */
+
+      namespace detail
+      {
+          constexpr ImVec4 HexColor(ImU32 rgb)
+          {
+              return ImVec4(((rgb >> 16) & 0xFF) / 255.0f, ((rgb >> 8) & 0xFF) / 255.0f, (rgb & 0xFF) / 255.0f, 1.0f);
+          }
+      }
+
+      class Colormap
+      {
+      public:
+          static const int Resolution = 256;
+
+          // Grayscale
+          Colormap()
+          {
+              for (int i = 0; i < Resolution; i++)
+                  Table[i] = IM_COL32(i, i, i, 255);
+          }
+
+          // Bakes a Gradient<N> or any gradient.h gradient over its whole key range
+          template<typename G>
+          explicit Colormap(const G& source)
+              : SourceFirst(detail::FirstKey(source)), SourceLast(detail::LastKey(source)), SourceVersion(gradient::detail::version_of(source, 0))
+          {
+              Resample(source, 0, Resolution);
+          }
+
+          // Re-samples the entries a gradient.h source changed since it was baked or last updated, over the key
+          // range it was baked with. The changed entries are [*first_index, *last_index], false when none.
+          template<typename G>
+          bool Update(const G& source, int* first_index = NULL, int* last_index = NULL)
+          {
+              const gradient::KeyRange<typename G::key_type> changed = source.changedSince(SourceVersion);
+              SourceVersion = source.version();
+              if (changed.empty() || double(changed.last) < SourceFirst || double(changed.first) > SourceLast)
+                  return false;
+
+              // One extra entry on each side absorbs the rounding of the positions
+              const double scale = SourceLast > SourceFirst ? (Resolution - 1) / (SourceLast - SourceFirst) : 0.0;
+              const int first = std::max(int((std::max(double(changed.first), SourceFirst) - SourceFirst) * scale) - 1, 0);
+              const int last = std::min(int((std::min(double(changed.last), SourceLast) - SourceFirst) * scale) + 1, Resolution - 1);
+              Resample(source, first, last + 1);
+              if (first_index) *first_index = first;
+              if (last_index) *last_index = last;
+              return true;
+          }
+
+          // Perceptually uniform presets, built on first use
+          static const Colormap& Viridis()
+          {
+              static const Colormap map(Gradient<11>{{
+                  detail::HexColor(0x440154), detail::HexColor(0x482475), detail::HexColor(0x414487), detail::HexColor(0x355F8D),
+                  detail::HexColor(0x2A788E), detail::HexColor(0x21918C), detail::HexColor(0x22A884), detail::HexColor(0x44BF70),
+                  detail::HexColor(0x7AD151), detail::HexColor(0xBDDF26), detail::HexColor(0xFDE725) }});
+              return map;
+          }
+
+          static const Colormap& Magma()
+          {
+              static const Colormap map(Gradient<11>{{
+                  detail::HexColor(0x000004), detail::HexColor(0x140E36), detail::HexColor(0x3B0F70), detail::HexColor(0x641A80),
+                  detail::HexColor(0x8C2981), detail::HexColor(0xB73779), detail::HexColor(0xDE4968), detail::HexColor(0xF7705C),
+                  detail::HexColor(0xFE9F6D), detail::HexColor(0xFECF92), detail::HexColor(0xFCFDBF) }});
+              return map;
+          }
+
+          // Polynomial approximation of Turbo, https://ai.googleblog.com/2019/08/turbo-improved-rainbow-colormap-for.html
+          static const Colormap& Turbo()
+          {
+              struct TurboMap : Colormap
+              {
+                  TurboMap()
+                  {
+                      for (int i = 0; i < Resolution; i++)
+                      {
+                          const float x = float(i) / (Resolution - 1);
+                          const ImVec4 c(0.13572138f + x * (4.61539260f + x * (-42.66032258f + x * (132.13108234f + x * (-152.94239396f + x * 59.28637943f)))),
+                                         0.09140261f + x * (2.19418839f + x * (4.84296658f + x * (-14.18503333f + x * (4.27729857f + x * 2.82956604f)))),
+                                         0.10667330f + x * (12.64194608f + x * (-60.58204836f + x * (110.36276771f + x * (-89.90310912f + x * 27.34824973f)))),
+                                         1.0f);
+                          Table[i] = detail::PackColor(c);
+                      }
+                  }
+              };
+              static const TurboMap map;
+              return map;
+          }
+
+          // Values at or below min get the first color, at or above max the last one
+          void SetRange(float min, float max)
+          {
+              Min = min;
+              Max = max;
+          }
+
+          ImU32 Map(float value) const { return Table[Index(value, Scale(), Offset())]; }
+
+          void Map(const float* values, size_t count, ImU32* out) const { MapRow(values, count, out); }
+          void Map(const ImU16* values, size_t count, ImU32* out) const { MapRow(values, count, out); }
+          void Map(const ImU8* values, size_t count, ImU32* out) const
+          {
+              IMCANDY_METRICS_SCOPE(Colormap, count);
+              IMCANDY_METRICS_HITS(Colormap, count);
+
+              // Every possible input is resolved once, then it is a plain lookup
+              ImU32 direct[256];
+              for (int v = 0; v < 256; v++)
+                  direct[v] = Map(float(v));
+              for (size_t i = 0; i < count; i++)
+                  out[i] = direct[values[i]];
+          }
+
+          // Sub-rectangle of a 2D field, strides are in elements
+          template<typename T>
+          void MapRect(const T* values, int values_stride, ImU32* pixels, int pixels_stride, int x, int y, int w, int h) const
+          {
+              for (int row = y; row < y + h; row++)
+                  Map(values + size_t(row) * values_stride + x, size_t(w), pixels + size_t(row) * pixels_stride + x);
+          }
+
+          // Table indices instead of colors, ColormapImage keeps them to recolor without the field
+          template<typename T>
+          void MapIndices(const T* values, size_t count, ImU8* indices) const
+          {
+              static_assert(Resolution <= 256, "indices are 8-bit");
+              IMCANDY_METRICS_SCOPE(Colormap, count);
+              const float scale = Scale(), offset = Offset();
+              for (size_t i = 0; i < count; i++)
+                  indices[i] = ImU8(Index(float(values[i]), scale, offset));
+          }
+
+          const ImU32* GetTable() const { return Table; }
+          float GetMin() const { return Min; }
+          float GetMax() const { return Max; }
+
+      protected:
+          ImU32 Table[Resolution];
+
+      private:
+          float Scale() const { return Max != Min ? (Resolution - 1) / (Max - Min) : 0.0f; }
+          float Offset() const { return -Min * Scale() + 0.5f; }
+
+          // NaN maps to the first color
+          static int Index(float value, float scale, float offset)
+          {
+              const float x = value * scale + offset;
+              return !(x > 0.0f) ? 0 : x >= float(Resolution - 1) ? Resolution - 1 : int(x);
+          }
+
+          template<typename G>
+          void Resample(const G& source, int begin, int end)
+          {
+              typename detail::KeyType<G>::Type keys[gradient::detail::batch_block];
+              typename detail::ScratchType<G>::Type scratch;
+              for (int i = begin; i < end; i += gradient::detail::batch_block)
+              {
+                  const int count = std::min<int>(gradient::detail::batch_block, end - i);
+                  for (int k = 0; k < count; k++)
+                      keys[k] = typename detail::KeyType<G>::Type(SourceFirst + (SourceLast - SourceFirst) * (i + k) / (Resolution - 1));
+                  detail::EvaluateColors(source, keys, count, Table + i, scratch);
+              }
+          }
+
+          template<typename T>
+          void MapRow(const T* values, size_t count, ImU32* out) const
+          {
+              IMCANDY_METRICS_SCOPE(Colormap, count);
+              IMCANDY_METRICS_HITS(Colormap, count);
+              const float scale = Scale(), offset = Offset();
+              for (size_t i = 0; i < count; i++)
+                  out[i] = Table[Index(float(values[i]), scale, offset)];
+          }
+
+          float Min = 0.0f;
+          float Max = 1.0f;
+          double SourceFirst = 0.0, SourceLast = 1.0;   // Key range the table was baked over
+          uint64_t SourceVersion = 0;
+      };
+
+      // Pixels of a whole scalar field plus the rectangle that changed since ClearDirty()
+      class ColormapImage
+      {
+      public:
+          Colormap Map;
+
+          ColormapImage() {}
+          ColormapImage(int width, int height) { Resize(width, height); }
+
+          // New contents are transparent black pixels with index 0 until the next SetData()
+          void Resize(int width, int height)
+          {
+              IM_ASSERT(width >= 0 && height >= 0);
+              const size_t count = size_t(width) * size_t(height);
+              IM_ASSERT(count <= size_t(INT_MAX));    // ImVector sizes are int
+              Width = width;
+              Height = height;
+              Pixels.resize(int(count));
+              Indices.resize(int(count));
+              RowLo.resize(height);
+              RowHi.resize(height);
+              if (count > 0)
+              {
+                  memset(Pixels.Data, 0, size_t(Pixels.size_in_bytes()));
+                  memset(Indices.Data, 0, size_t(Indices.size_in_bytes()));
+                  memset(RowLo.Data, 0, size_t(RowLo.size_in_bytes()));
+                  memset(RowHi.Data, 0, size_t(RowHi.size_in_bytes()));
+              }
+              MarkDirty(0, 0, width, height);
+          }
+
+          // Recolors the whole field, stride in elements
+          template<typename T>
+          void SetData(const T* values, int values_stride)
+          {
+              Update(values, values_stride, 0, 0, Width, Height);
+          }
+
+          // Recolors the cells of [x, x + w) x [y, y + h) only, 'values' is the whole field
+          template<typename T>
+          void Update(const T* values, int values_stride, int x, int y, int w, int h)
+          {
+              const int x0 = std::max(x, 0), y0 = std::max(y, 0);
+              const int x1 = std::min(x + w, Width), y1 = std::min(y + h, Height);
+              if (x1 <= x0 || y1 <= y0)
+                  return;
+
+              const ImU32* table = Map.GetTable();
+              for (int row = y0; row < y1; row++)
+              {
+                  const size_t offset = size_t(row) * Width + x0;
+                  Map.MapIndices(values + size_t(row) * values_stride + x0, size_t(x1 - x0), Indices.Data + offset);
+                  const bool whole_row = x0 == 0 && x1 == Width;
+                  ImU8 lo = whole_row ? ImU8(255) : RowLo[row], hi = whole_row ? ImU8(0) : RowHi[row];
+                  for (int i = 0; i < x1 - x0; i++)
+                  {
+                      const ImU8 index = Indices[offset + i];
+                      Pixels[offset + i] = table[index];
+                      lo = std::min(lo, index); hi = std::max(hi, index);
+                  }
+                  RowLo[row] = lo;
+                  RowHi[row] = hi;
+              }
+              MarkDirty(x0, y0, x1 - x0, y1 - y0);
+          }
+
+          // Recolors the pixels whose value maps to table entries [first_index, last_index] from the stored
+          // indices, without the field. Call it after editing Map's table (a range change needs SetData()).
+          // Only the rows holding one of those entries are scanned, but such a row is scanned whole: a
+          // narrow table edit over a field whose rows span the whole range still costs one pass per pixel.
+          void Recolor(int first_index = 0, int last_index = Colormap::Resolution - 1)
+          {
+              IMCANDY_METRICS_SCOPE(Colormap, Pixels.Size);
+              const ImU32* table = Map.GetTable();
+              int y0 = Height, y1 = -1, x0 = Width, x1 = -1;
+              for (int y = 0; y < Height; y++)
+              {
+                  if (RowHi[y] < first_index || RowLo[y] > last_index)
+                      continue;
+                  const ImU8* indices = Indices.Data + size_t(y) * Width;
+                  ImU32* pixels = Pixels.Data + size_t(y) * Width;
+                  for (int x = 0; x < Width; x++)
+                  {
+                      if (indices[x] < first_index || indices[x] > last_index)
+                          continue;
+                      pixels[x] = table[indices[x]];
+                      x0 = std::min(x0, x); x1 = std::max(x1, x);
+                      y0 = std::min(y0, y); y1 = y;
+                  }
+              }
+              if (y1 >= 0)
+                  MarkDirty(x0, y0, x1 - x0 + 1, y1 - y0 + 1);
+          }
+
+          // Re-samples the part of Map a gradient.h source changed (see Colormap::Update()),
+          // then recolors only the pixels using those entries
+          template<typename G>
+          bool UpdateMap(const G& source)
+          {
+              int first = 0, last = 0;
+              if (!Map.Update(source, &first, &last))
+                  return false;
+              Recolor(first, last);
+              return true;
+          }
+
+          // Union of the updated rectangles, false when nothing changed
+          bool GetDirtyRect(int* x, int* y, int* w, int* h) const
+          {
+              if (DirtyX1 <= DirtyX0 || DirtyY1 <= DirtyY0)
+                  return false;
+              *x = DirtyX0; *y = DirtyY0; *w = DirtyX1 - DirtyX0; *h = DirtyY1 - DirtyY0;
+              return true;
+          }
+
+          void MarkDirty(int x, int y, int w, int h)
+          {
+              if (DirtyX1 <= DirtyX0 || DirtyY1 <= DirtyY0)
+              {
+                  DirtyX0 = x; DirtyY0 = y; DirtyX1 = x + w; DirtyY1 = y + h;
+                  return;
+              }
+              DirtyX0 = std::min(DirtyX0, x); DirtyY0 = std::min(DirtyY0, y);
+              DirtyX1 = std::max(DirtyX1, x + w); DirtyY1 = std::max(DirtyY1, y + h);
+          }
+
+          void ClearDirty() { DirtyX0 = DirtyY0 = DirtyX1 = DirtyY1 = 0; }
+
+          int GetWidth() const { return Width; }
+          int GetHeight() const { return Height; }
+
+          // Row-major RGBA8, GetWidth() pixels per row
+          const ImU32* GetPixels(int x = 0, int y = 0) const { return Pixels.Data + size_t(y) * Width + x; }
+
+      private:
+          ImVector<ImU32> Pixels;
+          ImVector<ImU8>  Indices;    // Colormap table entry of every pixel
+          ImVector<ImU8>  RowLo;      // Bounds of the entries used by each row, may be wider after partial updates
+          ImVector<ImU8>  RowHi;
+          int Width = 0, Height = 0;
+          int DirtyX0 = 0, DirtyY0 = 0, DirtyX1 = 0, DirtyY1 = 0;
+      };
+
+      /*---------------------------------------------------------------------------------------------------------
+                                                       ANIMATION                                               */
+
+      /*
+      Time based alternative to the static_ratio functions above. The phase is derived from ImGui::GetTime(),
+      so speeds are in cycles per second whatever the frame rate, and every id is evaluated at most once per
+      frame: drawing a widget twice does not advance it twice, later lookups come from a cache.
+      Example usage:
+      ---------------------------------------------------------------
+        ImGui::PushStyleColor(ImGuiCol_Border, ImCandy::GetAnimator().Rainbow(ImGui::GetID("border")));
+      ---------------------------------------------------------------
+      */
+
+      namespace detail
+      {
+          // Fastest color change of a gradient cycled at cycles_per_second, in 0-1 units per second
+          inline float CycleRate(const ImVec4* stops, int count, float cycles_per_second)
+          {
+              float max_delta = 0.0f;
+              for (int i = 0; i < count - 1; i++)
+              {
+                  const ImVec4& lo = stops[i];
+                  const ImVec4& hi = stops[i + 1];
+                  max_delta = std::max(max_delta, std::max(std::max(fabsf(hi.x - lo.x), fabsf(hi.y - lo.y)), std::max(fabsf(hi.z - lo.z), fabsf(hi.w - lo.w))));
+              }
+              return max_delta * fabsf(cycles_per_second) * float(count - 1);
+          }
 
-      void Theme_Blender(ImGuiStyle* dst = NULL)  
-      {
-        // 'Blender Dark' theme from v3.0.0 [Improvised]
-        // Colors grabbed using X11 Soft/xcolor
-        ImGuiStyle* style = dst ? dst : &ImGui::GetStyle();
-        ImVec4* colors = style->Colors;
-        ImGui::StyleColorsDark(style);//Reset to base/dark theme
-        colors[ImGuiCol_Text]                   = ImVec4(0.84f, 0.84f, 0.84f, 1.00f);
-        colors[ImGuiCol_WindowBg]               = ImVec4(0.22f, 0.22f, 0.22f, 1.00f);
-        colors[ImGuiCol_ChildBg]                = ImVec4(0.19f, 0.19f, 0.19f, 1.00f);
-        colors[ImGuiCol_PopupBg]                = ImVec4(0.09f, 0.09f, 0.09f, 1.00f);
-        colors[ImGuiCol_Border]                 = ImVec4(0.17f, 0.17f, 0.17f, 1.00f);
-        colors[ImGuiCol_BorderShadow]           = ImVec4(0.10f, 0.10f, 0.10f, 0.00f);
-        colors[ImGuiCol_FrameBg]                = ImVec4(0.33f, 0.33f, 0.33f, 1.00f);
-        colors[ImGuiCol_FrameBgHovered]         = ImVec4(0.47f, 0.47f, 0.47f, 1.00f);
-        colors[ImGuiCol_FrameBgActive]          = ImVec4(0.16f, 0.16f, 0.16f, 1.00f);
-        colors[ImGuiCol_TitleBg]                = ImVec4(0.11f, 0.11f, 0.11f, 1.00f);
-        colors[ImGuiCol_TitleBgActive]          = ImVec4(0.28f, 0.45f, 0.70f, 1.00f);
-        colors[ImGuiCol_MenuBarBg]              = ImVec4(0.11f, 0.11f, 0.11f, 1.00f);
-        colors[ImGuiCol_ScrollbarGrab]          = ImVec4(0.33f, 0.33f, 0.33f, 1.00f);
-        colors[ImGuiCol_ScrollbarGrabHovered]   = ImVec4(0.33f, 0.33f, 0.33f, 1.00f);
-        colors[ImGuiCol_ScrollbarGrabActive]    = ImVec4(0.35f, 0.35f, 0.35f, 1.00f);
-        colors[ImGuiCol_CheckMark]              = ImVec4(0.28f, 0.45f, 0.70f, 1.00f);
-        colors[ImGuiCol_SliderGrab]             = ImVec4(0.28f, 0.45f, 0.70f, 1.00f);
-        colors[ImGuiCol_SliderGrabActive]       = ImVec4(0.28f, 0.45f, 0.70f, 1.00f);
-        colors[ImGuiCol_Button]                 = ImVec4(0.33f, 0.33f, 0.33f, 1.00f);
-        colors[ImGuiCol_ButtonHovered]          = ImVec4(0.40f, 0.40f, 0.40f, 1.00f);
-        colors[ImGuiCol_ButtonActive]           = ImVec4(0.28f, 0.45f, 0.70f, 1.00f);
-        colors[ImGuiCol_Header]                 = ImVec4(0.27f, 0.27f, 0.27f, 1.00f);
-        colors[ImGuiCol_HeaderHovered]          = ImVec4(0.28f, 0.45f, 0.70f, 1.00f);
-        colors[ImGuiCol_HeaderActive]           = ImVec4(0.27f, 0.27f, 0.27f, 1.00f);
-        colors[ImGuiCol_Separator]              = ImVec4(0.18f, 0.18f, 0.18f, 1.00f);
-        colors[ImGuiCol_SeparatorHovered]       = ImVec4(0.28f, 0.45f, 0.70f, 1.00f);
-        colors[ImGuiCol_SeparatorActive]        = ImVec4(0.28f, 0.45f, 0.70f, 1.00f);
-        colors[ImGuiCol_ResizeGrip]             = ImVec4(0.54f, 0.54f, 0.54f, 1.00f);
-        colors[ImGuiCol_ResizeGripHovered]      = ImVec4(0.28f, 0.45f, 0.70f, 1.00f);
-        colors[ImGuiCol_ResizeGripActive]       = ImVec4(0.19f, 0.39f, 0.69f, 1.00f);
-        colors[ImGuiCol_Tab]                    = ImVec4(0.11f, 0.11f, 0.11f, 1.00f);
-        colors[ImGuiCol_TabHovered]             = ImVec4(0.14f, 0.14f, 0.14f, 1.00f);
-        colors[ImGuiCol_TabActive]              = ImVec4(0.19f, 0.19f, 0.19f, 1.00f);
-        colors[ImGuiCol_PlotHistogram]          = ImVec4(0.28f, 0.45f, 0.70f, 1.00f);
-        colors[ImGuiCol_PlotHistogramHovered]   = ImVec4(0.20f, 0.39f, 0.69f, 1.00f);
-        colors[ImGuiCol_TextSelectedBg]         = ImVec4(0.28f, 0.45f, 0.70f, 1.00f);
-        colors[ImGuiCol_NavHighlight]           = ImVec4(0.28f, 0.45f, 0.70f, 1.00f);
-        style->WindowPadding                    = ImVec2(12.00f, 8.00f);
-        style->ItemSpacing                      = ImVec2(7.00f, 3.00f);
-        style->GrabMinSize                      = 20.00f;
-        style->WindowRounding                   = 8.00f;
-        style->FrameBorderSize                  = 0.00f;
-        style->FrameRounding                    = 4.00f;
-        style->GrabRounding                     = 12.00f;
-      }
-
-      void Theme_Cyberpunk(ImGuiStyle* dst = NULL)  
-      {
-        // Cyberpunk Neon [Improvised]
-        // https://github.com/Roboron3042/Cyberpunk-Neon
-        ImGuiStyle* style = dst ? dst : &ImGui::GetStyle();
-        ImVec4* colors = style->Colors;
-        ImGui::StyleColorsDark(style);//Reset to base/dark theme
-        colors[ImGuiCol_Text]                   = ImVec4(0.00f, 0.82f, 1.00f, 1.00f);
-        colors[ImGuiCol_TextDisabled]           = ImVec4(0.00f, 0.36f, 0.63f, 1.00f);
-        colors[ImGuiCol_WindowBg]               = ImVec4(0.00f, 0.04f, 0.12f, 1.00f);
-        colors[ImGuiCol_ChildBg]                = ImVec4(0.03f, 0.04f, 0.22f, 1.00f);
-        colors[ImGuiCol_PopupBg]                = ImVec4(0.12f, 0.06f, 0.27f, 1.00f);
-        colors[ImGuiCol_Border]                 = ImVec4(0.61f, 0.00f, 1.00f, 1.00f);
-        colors[ImGuiCol_FrameBg]                = ImVec4(0.00f, 0.75f, 1.00f, 0.20f);
-        colors[ImGuiCol_FrameBgHovered]         = ImVec4(0.34f, 0.00f, 1.00f, 1.00f);
-        colors[ImGuiCol_FrameBgActive]          = ImVec4(0.08f, 0.00f, 1.00f, 1.00f);
-        colors[ImGuiCol_TitleBg]                = ImVec4(0.00f, 0.81f, 0.95f, 1.00f);
-        colors[ImGuiCol_TitleBgActive]          = ImVec4(0.61f, 0.00f, 1.00f, 1.00f);
-        colors[ImGuiCol_TitleBgCollapsed]       = ImVec4(0.25f, 0.00f, 0.54f, 0.81f);
-        colors[ImGuiCol_MenuBarBg]              = ImVec4(0.61f, 0.00f, 1.00f, 1.00f);
-        colors[ImGuiCol_ScrollbarBg]            = ImVec4(0.00f, 0.88f, 1.00f, 1.00f);
-        colors[ImGuiCol_ScrollbarGrab]          = ImVec4(0.61f, 0.00f, 1.00f, 1.00f);
-        colors[ImGuiCol_ScrollbarGrabHovered]   = ImVec4(0.01f, 0.00f, 1.00f, 1.00f);
-        colors[ImGuiCol_ScrollbarGrabActive]    = ImVec4(0.95f, 0.19f, 0.67f, 1.00f);
-        colors[ImGuiCol_CheckMark]              = ImVec4(0.95f, 0.19f, 0.92f, 1.00f);
-        colors[ImGuiCol_SliderGrab]             = ImVec4(0.00f, 1.00f, 0.95f, 1.00f);
-        colors[ImGuiCol_SliderGrabActive]       = ImVec4(0.81f, 0.00f, 1.00f, 1.00f);
-        colors[ImGuiCol_Button]                 = ImVec4(0.00f, 0.98f, 1.00f, 0.52f);
-        colors[ImGuiCol_ButtonHovered]          = ImVec4(0.94f, 0.00f, 1.00f, 0.80f);
-        colors[ImGuiCol_ButtonActive]           = ImVec4(0.01f, 0.00f, 1.00f, 1.00f);
-        colors[ImGuiCol_Header]                 = ImVec4(0.00f, 0.95f, 1.00f, 0.40f);
-        colors[ImGuiCol_HeaderHovered]          = ImVec4(0.94f, 0.00f, 1.00f, 0.80f);
-        colors[ImGuiCol_HeaderActive]           = ImVec4(0.01f, 0.00f, 1.00f, 1.00f);
-        colors[ImGuiCol_Separator]              = ImVec4(0.74f, 0.00f, 1.00f, 0.50f);
-        colors[ImGuiCol_SeparatorHovered]       = ImVec4(0.34f, 0.00f, 1.00f, 0.78f);
-        colors[ImGuiCol_SeparatorActive]        = ImVec4(0.00f, 1.00f, 0.85f, 1.00f);
-        colors[ImGuiCol_ResizeGrip]             = ImVec4(0.61f, 0.00f, 1.00f, 1.00f);
-        colors[ImGuiCol_ResizeGripHovered]      = ImVec4(0.89f, 0.26f, 0.98f, 0.67f);
-        colors[ImGuiCol_ResizeGripActive]       = ImVec4(0.00f, 0.88f, 1.00f, 0.95f);
-        colors[ImGuiCol_Tab]                    = ImVec4(0.36f, 0.00f, 1.00f, 1.00f);
-        colors[ImGuiCol_TabHovered]             = ImVec4(0.00f, 0.92f, 1.00f, 0.80f);
-        colors[ImGuiCol_TabActive]              = ImVec4(0.62f, 0.00f, 0.80f, 1.00f);
-        colors[ImGuiCol_PlotHistogram]          = ImVec4(0.00f, 1.00f, 0.88f, 1.00f);
-        style->FrameBorderSize                  = 0.00f;
-        style->WindowRounding                   = 0.00f;
-        style->FrameRounding                    = 0.00f;
-        style->ScrollbarRounding                = 0.00f;
-        style->GrabRounding                     = 0.00f;
-      }
-      
-      void Theme_Nord(ImGuiStyle* dst = NULL)  
-      {
-        // Nord/Nordic GTK [Improvised]
-        // https://github.com/EliverLara/Nordic
-        ImGuiStyle* style = dst ? dst : &ImGui::GetStyle();
-        ImVec4* colors = style->Colors;
-        ImGui::StyleColorsDark(style);//Reset to base/dark theme
-        colors[ImGuiCol_Text]                   = ImVec4(0.85f, 0.87f, 0.91f, 0.88f);
-        colors[ImGuiCol_TextDisabled]           = ImVec4(0.49f, 0.50f, 0.53f, 1.00f);
-        colors[ImGuiCol_WindowBg]               = ImVec4(0.18f, 0.20f, 0.25f, 1.00f);
-        colors[ImGuiCol_ChildBg]                = ImVec4(0.16f, 0.17f, 0.20f, 1.00f);
-        colors[ImGuiCol_PopupBg]                = ImVec4(0.23f, 0.26f, 0.32f, 1.00f);
-        colors[ImGuiCol_Border]                 = ImVec4(0.14f, 0.16f, 0.19f, 1.00f);
-        colors[ImGuiCol_BorderShadow]           = ImVec4(0.09f, 0.09f, 0.09f, 0.00f);
-        colors[ImGuiCol_FrameBg]                = ImVec4(0.23f, 0.26f, 0.32f, 1.00f);
-        colors[ImGuiCol_FrameBgHovered]         = ImVec4(0.56f, 0.74f, 0.73f, 1.00f);
-        colors[ImGuiCol_FrameBgActive]          = ImVec4(0.53f, 0.75f, 0.82f, 1.00f);
-        colors[ImGuiCol_TitleBg]                = ImVec4(0.16f, 0.16f, 0.20f, 1.00f);
-        colors[ImGuiCol_TitleBgActive]          = ImVec4(0.16f, 0.16f, 0.20f, 1.00f);
-        colors[ImGuiCol_TitleBgCollapsed]       = ImVec4(0.16f, 0.16f, 0.20f, 1.00f);
-        colors[ImGuiCol_MenuBarBg]              = ImVec4(0.16f, 0.16f, 0.20f, 1.00f);
-        colors[ImGuiCol_ScrollbarBg]            = ImVec4(0.18f, 0.20f, 0.25f, 1.00f);
-        colors[ImGuiCol_ScrollbarGrab]          = ImVec4(0.23f, 0.26f, 0.32f, 0.60f);
-        colors[ImGuiCol_ScrollbarGrabHovered]   = ImVec4(0.23f, 0.26f, 0.32f, 1.00f);
-        colors[ImGuiCol_ScrollbarGrabActive]    = ImVec4(0.23f, 0.26f, 0.32f, 1.00f);
-        colors[ImGuiCol_CheckMark]              = ImVec4(0.37f, 0.51f, 0.67f, 1.00f);
-        colors[ImGuiCol_SliderGrab]             = ImVec4(0.51f, 0.63f, 0.76f, 1.00f);
-        colors[ImGuiCol_SliderGrabActive]       = ImVec4(0.37f, 0.51f, 0.67f, 1.00f);
-        colors[ImGuiCol_Button]                 = ImVec4(0.18f, 0.20f, 0.25f, 1.00f);
-        colors[ImGuiCol_ButtonHovered]          = ImVec4(0.51f, 0.63f, 0.76f, 1.00f);
-        colors[ImGuiCol_ButtonActive]           = ImVec4(0.37f, 0.51f, 0.67f, 1.00f);
-        colors[ImGuiCol_Header]                 = ImVec4(0.51f, 0.63f, 0.76f, 1.00f);
-        colors[ImGuiCol_HeaderHovered]          = ImVec4(0.53f, 0.75f, 0.82f, 1.00f);
-        colors[ImGuiCol_HeaderActive]           = ImVec4(0.37f, 0.51f, 0.67f, 1.00f);
-        colors[ImGuiCol_SeparatorHovered]       = ImVec4(0.56f, 0.74f, 0.73f, 1.00f);
-        colors[ImGuiCol_SeparatorActive]        = ImVec4(0.53f, 0.75f, 0.82f, 1.00f);
-        colors[ImGuiCol_ResizeGrip]             = ImVec4(0.53f, 0.75f, 0.82f, 0.86f);
-        colors[ImGuiCol_ResizeGripHovered]      = ImVec4(0.61f, 0.74f, 0.87f, 1.00f);
-        colors[ImGuiCol_ResizeGripActive]       = ImVec4(0.37f, 0.51f, 0.67f, 1.00f);
-        colors[ImGuiCol_Tab]                    = ImVec4(0.18f, 0.20f, 0.25f, 1.00f);
-        colors[ImGuiCol_TabHovered]             = ImVec4(0.22f, 0.24f, 0.31f, 1.00f);
-        colors[ImGuiCol_TabActive]              = ImVec4(0.23f, 0.26f, 0.32f, 1.00f);
-        colors[ImGuiCol_TabUnfocused]           = ImVec4(0.13f, 0.15f, 0.18f, 1.00f);
-        colors[ImGuiCol_TabUnfocusedActive]     = ImVec4(0.17f, 0.19f, 0.23f, 1.00f);
-        colors[ImGuiCol_PlotHistogram]          = ImVec4(0.56f, 0.74f, 0.73f, 1.00f);
-        colors[ImGuiCol_PlotHistogramHovered]   = ImVec4(0.53f, 0.75f, 0.82f, 1.00f);
-        colors[ImGuiCol_TextSelectedBg]         = ImVec4(0.37f, 0.51f, 0.67f, 1.00f);
-        colors[ImGuiCol_NavHighlight]           = ImVec4(0.53f, 0.75f, 0.82f, 0.86f);
-        style->WindowBorderSize                 = 1.00f;
-        style->ChildBorderSize                  = 1.00f;
-        style->PopupBorderSize                  = 1.00f;
-        style->FrameBorderSize                  = 1.00f;
+          // Seconds from 'time' until a color changing at 'rate' can move by one 8-bit step, FLT_MAX when it does
+          // not change. The steps are counted from time 0. With a cap they are rounded up to whole 1 / max_fps
+          // periods, so the result lands on the next boundary of the quantized time.
+          inline float TimeUntilNextChange(float rate, float max_fps, double time)
+          {
+              if (rate <= 0.0f)
+                  return FLT_MAX;
+              double quantum = (1.0 / 255.0) / rate;
+              if (max_fps > 0.0f)
+                  quantum = std::max(1.0, ceil(quantum * max_fps - 1e-6)) / max_fps;
+              return float(quantum - fmod(std::max(time, 0.0), quantum));
+          }
       }
 
+      class Animator
+      {
+      public:
+          // Caps how often animated colors change: time is quantized to 1 / MaxFPS seconds (0 = no cap)
+          float MaxFPS = 0.0f;
+
+          // The default speeds match the default step of the static_ratio functions at 60 FPS
+          ImVec4 Rainbow(ImGuiID id, float cycles_per_second = 0.6f, float phase = 0.0f)
+          {
+              static const RainbowGradient gradient;
+              return Animate(id, gradient, cycles_per_second, phase);
+          }
+
+          ImVec4 Gradient2(ImGuiID id, ImVec4 col1, ImVec4 col2, float cycles_per_second = 0.3f, float phase = 0.0f)
+          {
+              col1.w = col2.w = 1.0f;
+              return Animate(id, Gradient<3>{{ col1, col2, col1 }}, cycles_per_second, phase);
+          }
+
+          ImVec4 Gradient3(ImGuiID id, ImVec4 col1, ImVec4 col2, ImVec4 col3, float cycles_per_second = 0.2f, float phase = 0.0f)
+          {
+              col1.w = col2.w = col3.w = 1.0f;
+              return Animate(id, Gradient<4>{{ col1, col2, col3, col1 }}, cycles_per_second, phase);
+          }
+
+          // One cycle runs through the whole gradient, phase is an offset in cycles.
+          // The first call for an id in a frame wins, later calls with the same id return its color.
+          template<int N>
+          ImVec4 Animate(ImGuiID id, const Gradient<N>& gradient, float cycles_per_second, float phase = 0.0f)
+          {
+              IMCANDY_METRICS_SCOPE(Animator, 1);
+              const int frame = ImGui::GetFrameCount();
+              Entry* entry = GetOrAddEntry(id);
+              if (entry->Frame == frame)
+              {
+                  IMCANDY_METRICS_HITS(Animator, 1);
+                  return entry->Color;
+              }
+
+              double time = ImGui::GetTime();
+              if (MaxFPS > 0.0f)
+                  time = floor(time * MaxFPS) / MaxFPS;
+
+              double cycle = time * cycles_per_second + phase;
+              cycle -= floor(cycle);
+
+              entry->Frame = frame;
+              entry->Color = gradient.Evaluate(cycle * (N - 1));
+              entry->Rate = detail::CycleRate(gradient.Stops, N, cycles_per_second);
+              return entry->Color;
+          }
+
+          // Seconds until any color animated during the current or previous frame can change by one 8-bit step,
+          // up to the next 1 / MaxFPS boundary with a cap, FLT_MAX when nothing is animating. Hosts that only render on input can
+          // sleep that long (e.g. glfwWaitEventsTimeout()) instead of redrawing at vsync.
+          // Only covers this animator: StyleBindings has the same query, ImCandy::GetTimeUntilNextChange()
+          // takes the smaller of the shared animator's and the shared bindings'.
+          float GetTimeUntilNextChange() const
+          {
+              const int frame = ImGui::GetFrameCount();
+              float rate = 0.0f;
+              for (int i = 0; i < Entries.Size; i++)
+                  if (frame - Entries[i].Frame <= 1)
+                      rate = std::max(rate, Entries[i].Rate);
+              return detail::TimeUntilNextChange(rate, MaxFPS, ImGui::GetTime());
+          }
+
+          // Forgets the ids that have not been animated for max_idle_frames
+          void Compact(int max_idle_frames = 600)
+          {
+              const int frame = ImGui::GetFrameCount();
+              int kept = 0;
+              for (int i = 0; i < Entries.Size; i++)
+                  if (frame - Entries[i].Frame <= max_idle_frames)
+                      Entries[kept++] = Entries[i];
+              Entries.resize(kept);
+          }
+
+          void Clear() { Entries.clear(); }
+
+      private:
+          struct Entry
+          {
+              ImGuiID ID;
+              int     Frame;
+              ImVec4  Color;
+              float   Rate;     // Max color change per second, in 0-1 units
+          };
+
+          // Sorted by ID, binary searched like ImGuiStorage
+          ImVector<Entry> Entries;
+
+          Entry* GetOrAddEntry(ImGuiID id)
+          {
+              Entry* first = Entries.begin();
+              int count = Entries.Size;
+              while (count > 0)
+              {
+                  int half = count >> 1;
+                  if (first[half].ID < id)
+                  {
+                      first += half + 1;
+                      count -= half + 1;
+                  }
+                  else
+                  {
+                      count = half;
+                  }
+              }
+
+              if (first == Entries.end() || first->ID != id)
+              {
+                  Entry entry = { id, -1, ImVec4(), 0.0f };
+                  first = Entries.insert(first, entry);
+              }
+              return first;
+          }
+      };
+
+      // Shared animator used by the widgets of the default ImGui context
+      IMCANDY_API Animator& GetAnimator();
+
+      /*---------------------------------------------------------------------------------------------------------
+                                                        COLORS                                                 */
+
+      /*
+      Hue, saturation and lightness adjustments of colors, palettes and style color tables, done in HSL with
+      the batch kernels of gradient.h. Hue is added in turns, saturation is a factor (0 gray, 1 unchanged),
+      lightness is added (-1 black to 1 white). Alpha is left as is.
+      Accent color theme, re-tinted from the same base every frame so that nothing drifts:
+      ---------------------------------------------------------------
+        static const ImGuiStyle base = ImGui::GetStyle();
+        ImCandy::HueRotate(base, (float)ImGui::GetTime() * 0.05f);
+      ---------------------------------------------------------------
+      */
+
+      inline ImVec4 AdjustHSL(const ImVec4& col, float hue, float saturation = 1.0f, float lightness = 0.0f)
+      {
+          ImVec4 out;
+          gradient::adjust_hsl(&col.x, 1, hue, saturation, lightness, &out.x);
+          return out;
+      }
+
+      // src and dst may be the same array
+      inline void AdjustHSL(const ImVec4* src, ImVec4* dst, int count, float hue, float saturation = 1.0f, float lightness = 0.0f)
+      {
+          gradient::adjust_hsl(&src[0].x, std::size_t(count), hue, saturation, lightness, &dst[0].x);
+      }
+
+      // Fixed-point, within 3 per channel of the ImVec4 version
+      IMCANDY_API void AdjustHSL(const ImU32* src, ImU32* dst, int count, float hue, float saturation = 1.0f, float lightness = 0.0f);
+
+      // Colors of 'base' into dst (NULL = current style), the other style fields of dst are left as they are
+      IMCANDY_API void AdjustHSL(const ImGuiStyle& base, float hue, float saturation = 1.0f, float lightness = 0.0f, ImGuiStyle* dst = NULL);
+
+      inline ImVec4 HueRotate(const ImVec4& col, float turns)  { return AdjustHSL(col, turns); }
+      inline ImVec4 Saturate(const ImVec4& col, float factor)  { return AdjustHSL(col, 0.0f, factor); }
+      inline ImVec4 Lighten(const ImVec4& col, float amount)   { return AdjustHSL(col, 0.0f, 1.0f, amount); }
+
+      inline void HueRotate(const ImGuiStyle& base, float turns, ImGuiStyle* dst = NULL)  { AdjustHSL(base, turns, 1.0f, 0.0f, dst); }
+      inline void Saturate(const ImGuiStyle& base, float factor, ImGuiStyle* dst = NULL)  { AdjustHSL(base, 0.0f, factor, 0.0f, dst); }
+      inline void Lighten(const ImGuiStyle& base, float amount, ImGuiStyle* dst = NULL)   { AdjustHSL(base, 0.0f, 1.0f, amount, dst); }
+
+      /*---------------------------------------------------------------------------------------------------------
+                                                        THEMES                                                 */
+
+      // A theme as plain data: the full color table plus the style fields it changes.
+      // The MakeTheme_* functions build one on top of StyleColorsDark(), at compile time under C++14,
+      // so applying it is a single memcpy into ImGuiStyle::Colors.
+      struct Theme
+      {
+          struct ColorEntry { ImGuiCol Index; ImVec4 Value; };
+          struct FloatEntry { float ImGuiStyle::* Field; float Value; };
+          struct Vec2Entry  { ImVec2 ImGuiStyle::* Field; ImVec2 Value; };
+
+          ImVec4      Colors[ImGuiCol_COUNT];       // StyleColorsDark() with the overrides applied
+          ColorEntry  Overrides[ImGuiCol_COUNT];    // Only the colors the theme changes
+          int         OverridesCount;
+          FloatEntry  Floats[16];
+          int         FloatsCount;
+          Vec2Entry   Vec2s[8];
+          int         Vec2sCount;
+
+          // Each call adds an entry: at most ImGuiCol_COUNT colors, 16 float fields and 8 ImVec2 fields per theme
+          IMCANDY_CONSTEXPR14 void Set(ImGuiCol idx, const ImVec4& col)
+          {
+              IM_ASSERT(idx >= 0 && idx < ImGuiCol_COUNT && OverridesCount < IM_ARRAYSIZE(Overrides));
+              Colors[idx] = col;
+              Overrides[OverridesCount++] = ColorEntry{ idx, col };
+          }
+          IMCANDY_CONSTEXPR14 void Set(float ImGuiStyle::* field, float value)
+          {
+              IM_ASSERT(FloatsCount < IM_ARRAYSIZE(Floats));
+              Floats[FloatsCount++] = FloatEntry{ field, value };
+          }
+          IMCANDY_CONSTEXPR14 void Set(ImVec2 ImGuiStyle::* field, const ImVec2& value)
+          {
+              IM_ASSERT(Vec2sCount < IM_ARRAYSIZE(Vec2s));
+              Vec2s[Vec2sCount++] = Vec2Entry{ field, value };
+          }
+      };
+
+      namespace detail
+      {
+          constexpr ImVec4 ImLerpColor(const ImVec4& a, const ImVec4& b, float t)
+          {
+              return ImVec4(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t);
+          }
+
+          // MakeTheme_Dark() is transcribed from StyleColorsDark() of Dear ImGui 1.85, whose ImGuiCol_COUNT
+          // (53) matches every version from 1.80 to 1.90. With any other color count ApplyTheme() falls back
+          // to StyleColorsDark() plus the overrides.
+          constexpr int DarkTableColorCount = 53;
+#if defined(IMGUI_VERSION_NUM) && IMGUI_VERSION_NUM >= 18500 && IMGUI_VERSION_NUM < 18600
+          static_assert(ImGuiCol_COUNT == DarkTableColorCount, "MakeTheme_Dark() no longer matches the Dear ImGui 1.85 color table");
+#endif
+      }
+
+      // Transcription of ImGui::StyleColorsDark(), usable in constant expressions
+      inline IMCANDY_CONSTEXPR14 Theme MakeTheme_Dark()
+      {
+        Theme theme = {};
+        ImVec4* colors = theme.Colors;
+        colors[ImGuiCol_Text]                   = ImVec4(1.00f, 1.00f, 1.00f, 1.00f);
+        colors[ImGuiCol_TextDisabled]           = ImVec4(0.50f, 0.50f, 0.50f, 1.00f);
+        colors[ImGuiCol_WindowBg]               = ImVec4(0.06f, 0.06f, 0.06f, 0.94f);
+        colors[ImGuiCol_ChildBg]                = ImVec4(0.00f, 0.00f, 0.00f, 0.00f);
+        colors[ImGuiCol_PopupBg]                = ImVec4(0.08f, 0.08f, 0.08f, 0.94f);
+        colors[ImGuiCol_Border]                 = ImVec4(0.43f, 0.43f, 0.50f, 0.50f);
+        colors[ImGuiCol_BorderShadow]           = ImVec4(0.00f, 0.00f, 0.00f, 0.00f);
+        colors[ImGuiCol_FrameBg]                = ImVec4(0.16f, 0.29f, 0.48f, 0.54f);
+        colors[ImGuiCol_FrameBgHovered]         = ImVec4(0.26f, 0.59f, 0.98f, 0.40f);
+        colors[ImGuiCol_FrameBgActive]          = ImVec4(0.26f, 0.59f, 0.98f, 0.67f);
+        colors[ImGuiCol_TitleBg]                = ImVec4(0.04f, 0.04f, 0.04f, 1.00f);
+        colors[ImGuiCol_TitleBgActive]          = ImVec4(0.16f, 0.29f, 0.48f, 1.00f);
+        colors[ImGuiCol_TitleBgCollapsed]       = ImVec4(0.00f, 0.00f, 0.00f, 0.51f);
+        colors[ImGuiCol_MenuBarBg]              = ImVec4(0.14f, 0.14f, 0.14f, 1.00f);
+        colors[ImGuiCol_ScrollbarBg]            = ImVec4(0.02f, 0.02f, 0.02f, 0.53f);
+        colors[ImGuiCol_ScrollbarGrab]          = ImVec4(0.31f, 0.31f, 0.31f, 1.00f);
+        colors[ImGuiCol_ScrollbarGrabHovered]   = ImVec4(0.41f, 0.41f, 0.41f, 1.00f);
+        colors[ImGuiCol_ScrollbarGrabActive]    = ImVec4(0.51f, 0.51f, 0.51f, 1.00f);
+        colors[ImGuiCol_CheckMark]              = ImVec4(0.26f, 0.59f, 0.98f, 1.00f);
+        colors[ImGuiCol_SliderGrab]             = ImVec4(0.24f, 0.52f, 0.88f, 1.00f);
+        colors[ImGuiCol_SliderGrabActive]       = ImVec4(0.26f, 0.59f, 0.98f, 1.00f);
+        colors[ImGuiCol_Button]                 = ImVec4(0.26f, 0.59f, 0.98f, 0.40f);
+        colors[ImGuiCol_ButtonHovered]          = ImVec4(0.26f, 0.59f, 0.98f, 1.00f);
+        colors[ImGuiCol_ButtonActive]           = ImVec4(0.06f, 0.53f, 0.98f, 1.00f);
+        colors[ImGuiCol_Header]                 = ImVec4(0.26f, 0.59f, 0.98f, 0.31f);
+        colors[ImGuiCol_HeaderHovered]          = ImVec4(0.26f, 0.59f, 0.98f, 0.80f);
+        colors[ImGuiCol_HeaderActive]           = ImVec4(0.26f, 0.59f, 0.98f, 1.00f);
+        colors[ImGuiCol_Separator]              = colors[ImGuiCol_Border];
+        colors[ImGuiCol_SeparatorHovered]       = ImVec4(0.10f, 0.40f, 0.75f, 0.78f);
+        colors[ImGuiCol_SeparatorActive]        = ImVec4(0.10f, 0.40f, 0.75f, 1.00f);
+        colors[ImGuiCol_ResizeGrip]             = ImVec4(0.26f, 0.59f, 0.98f, 0.20f);
+        colors[ImGuiCol_ResizeGripHovered]      = ImVec4(0.26f, 0.59f, 0.98f, 0.67f);
+        colors[ImGuiCol_ResizeGripActive]       = ImVec4(0.26f, 0.59f, 0.98f, 0.95f);
+        colors[ImGuiCol_Tab]                    = detail::ImLerpColor(colors[ImGuiCol_Header],       colors[ImGuiCol_TitleBgActive], 0.80f);
+        colors[ImGuiCol_TabHovered]             = colors[ImGuiCol_HeaderHovered];
+        colors[ImGuiCol_TabActive]              = detail::ImLerpColor(colors[ImGuiCol_HeaderActive], colors[ImGuiCol_TitleBgActive], 0.60f);
+        colors[ImGuiCol_TabUnfocused]           = detail::ImLerpColor(colors[ImGuiCol_Tab],          colors[ImGuiCol_TitleBg], 0.80f);
+        colors[ImGuiCol_TabUnfocusedActive]     = detail::ImLerpColor(colors[ImGuiCol_TabActive],    colors[ImGuiCol_TitleBg], 0.40f);
+        colors[ImGuiCol_PlotLines]              = ImVec4(0.61f, 0.61f, 0.61f, 1.00f);
+        colors[ImGuiCol_PlotLinesHovered]       = ImVec4(1.00f, 0.43f, 0.35f, 1.00f);
+        colors[ImGuiCol_PlotHistogram]          = ImVec4(0.90f, 0.70f, 0.00f, 1.00f);
+        colors[ImGuiCol_PlotHistogramHovered]   = ImVec4(1.00f, 0.60f, 0.00f, 1.00f);
+        colors[ImGuiCol_TableHeaderBg]          = ImVec4(0.19f, 0.19f, 0.20f, 1.00f);
+        colors[ImGuiCol_TableBorderStrong]      = ImVec4(0.31f, 0.31f, 0.35f, 1.00f);
+        colors[ImGuiCol_TableBorderLight]       = ImVec4(0.23f, 0.23f, 0.25f, 1.00f);
+        colors[ImGuiCol_TableRowBg]             = ImVec4(0.00f, 0.00f, 0.00f, 0.00f);
+        colors[ImGuiCol_TableRowBgAlt]          = ImVec4(1.00f, 1.00f, 1.00f, 0.06f);
+        colors[ImGuiCol_TextSelectedBg]         = ImVec4(0.26f, 0.59f, 0.98f, 0.35f);
+        colors[ImGuiCol_DragDropTarget]         = ImVec4(1.00f, 1.00f, 0.00f, 0.90f);
+        colors[ImGuiCol_NavHighlight]           = ImVec4(0.26f, 0.59f, 0.98f, 1.00f);
+        colors[ImGuiCol_NavWindowingHighlight]  = ImVec4(1.00f, 1.00f, 1.00f, 0.70f);
+        colors[ImGuiCol_NavWindowingDimBg]      = ImVec4(0.80f, 0.80f, 0.80f, 0.20f);
+        colors[ImGuiCol_ModalWindowDimBg]       = ImVec4(0.80f, 0.80f, 0.80f, 0.35f);
+        return theme;
+      }
+
+      IMCANDY_API void ApplyTheme(const Theme& theme, ImGuiStyle* dst = NULL);
+
+      // 'Blender Dark' theme from v3.0.0 [Improvised]
+      // Colors grabbed using X11 Soft/xcolor
+      inline IMCANDY_CONSTEXPR14 Theme MakeTheme_Blender()
+      {
+        Theme theme = MakeTheme_Dark();
+        theme.Set(ImGuiCol_Text,                          ImVec4(0.84f, 0.84f, 0.84f, 1.00f));
+        theme.Set(ImGuiCol_WindowBg,                      ImVec4(0.22f, 0.22f, 0.22f, 1.00f));
+        theme.Set(ImGuiCol_ChildBg,                       ImVec4(0.19f, 0.19f, 0.19f, 1.00f));
+        theme.Set(ImGuiCol_PopupBg,                       ImVec4(0.09f, 0.09f, 0.09f, 1.00f));
+        theme.Set(ImGuiCol_Border,                        ImVec4(0.17f, 0.17f, 0.17f, 1.00f));
+        theme.Set(ImGuiCol_BorderShadow,                  ImVec4(0.10f, 0.10f, 0.10f, 0.00f));
+        theme.Set(ImGuiCol_FrameBg,                       ImVec4(0.33f, 0.33f, 0.33f, 1.00f));
+        theme.Set(ImGuiCol_FrameBgHovered,                ImVec4(0.47f, 0.47f, 0.47f, 1.00f));
+        theme.Set(ImGuiCol_FrameBgActive,                 ImVec4(0.16f, 0.16f, 0.16f, 1.00f));
+        theme.Set(ImGuiCol_TitleBg,                       ImVec4(0.11f, 0.11f, 0.11f, 1.00f));
+        theme.Set(ImGuiCol_TitleBgActive,                 ImVec4(0.28f, 0.45f, 0.70f, 1.00f));
+        theme.Set(ImGuiCol_MenuBarBg,                     ImVec4(0.11f, 0.11f, 0.11f, 1.00f));
+        theme.Set(ImGuiCol_ScrollbarGrab,                 ImVec4(0.33f, 0.33f, 0.33f, 1.00f));
+        theme.Set(ImGuiCol_ScrollbarGrabHovered,          ImVec4(0.33f, 0.33f, 0.33f, 1.00f));
+        theme.Set(ImGuiCol_ScrollbarGrabActive,           ImVec4(0.35f, 0.35f, 0.35f, 1.00f));
+        theme.Set(ImGuiCol_CheckMark,                     ImVec4(0.28f, 0.45f, 0.70f, 1.00f));
+        theme.Set(ImGuiCol_SliderGrab,                    ImVec4(0.28f, 0.45f, 0.70f, 1.00f));
+        theme.Set(ImGuiCol_SliderGrabActive,              ImVec4(0.28f, 0.45f, 0.70f, 1.00f));
+        theme.Set(ImGuiCol_Button,                        ImVec4(0.33f, 0.33f, 0.33f, 1.00f));
+        theme.Set(ImGuiCol_ButtonHovered,                 ImVec4(0.40f, 0.40f, 0.40f, 1.00f));
+        theme.Set(ImGuiCol_ButtonActive,                  ImVec4(0.28f, 0.45f, 0.70f, 1.00f));
+        theme.Set(ImGuiCol_Header,                        ImVec4(0.27f, 0.27f, 0.27f, 1.00f));
+        theme.Set(ImGuiCol_HeaderHovered,                 ImVec4(0.28f, 0.45f, 0.70f, 1.00f));
+        theme.Set(ImGuiCol_HeaderActive,                  ImVec4(0.27f, 0.27f, 0.27f, 1.00f));
+        theme.Set(ImGuiCol_Separator,                     ImVec4(0.18f, 0.18f, 0.18f, 1.00f));
+        theme.Set(ImGuiCol_SeparatorHovered,              ImVec4(0.28f, 0.45f, 0.70f, 1.00f));
+        theme.Set(ImGuiCol_SeparatorActive,               ImVec4(0.28f, 0.45f, 0.70f, 1.00f));
+        theme.Set(ImGuiCol_ResizeGrip,                    ImVec4(0.54f, 0.54f, 0.54f, 1.00f));
+        theme.Set(ImGuiCol_ResizeGripHovered,             ImVec4(0.28f, 0.45f, 0.70f, 1.00f));
+        theme.Set(ImGuiCol_ResizeGripActive,              ImVec4(0.19f, 0.39f, 0.69f, 1.00f));
+        theme.Set(ImGuiCol_Tab,                           ImVec4(0.11f, 0.11f, 0.11f, 1.00f));
+        theme.Set(ImGuiCol_TabHovered,                    ImVec4(0.14f, 0.14f, 0.14f, 1.00f));
+        theme.Set(ImGuiCol_TabActive,                     ImVec4(0.19f, 0.19f, 0.19f, 1.00f));
+        theme.Set(ImGuiCol_PlotHistogram,                 ImVec4(0.28f, 0.45f, 0.70f, 1.00f));
+        theme.Set(ImGuiCol_PlotHistogramHovered,          ImVec4(0.20f, 0.39f, 0.69f, 1.00f));
+        theme.Set(ImGuiCol_TextSelectedBg,                ImVec4(0.28f, 0.45f, 0.70f, 1.00f));
+        theme.Set(ImGuiCol_NavHighlight,                  ImVec4(0.28f, 0.45f, 0.70f, 1.00f));
+        theme.Set(&ImGuiStyle::WindowPadding,             ImVec2(12.00f, 8.00f));
+        theme.Set(&ImGuiStyle::ItemSpacing,               ImVec2(7.00f, 3.00f));
+        theme.Set(&ImGuiStyle::GrabMinSize,               20.00f);
+        theme.Set(&ImGuiStyle::WindowRounding,            8.00f);
+        theme.Set(&ImGuiStyle::FrameBorderSize,           0.00f);
+        theme.Set(&ImGuiStyle::FrameRounding,             4.00f);
+        theme.Set(&ImGuiStyle::GrabRounding,              12.00f);
+        return theme;
+      }
+
+      IMCANDY_API void Theme_Blender(ImGuiStyle* dst = NULL);
+
+      // Cyberpunk Neon [Improvised]
+      // https://github.com/Roboron3042/Cyberpunk-Neon
+      inline IMCANDY_CONSTEXPR14 Theme MakeTheme_Cyberpunk()
+      {
+        Theme theme = MakeTheme_Dark();
+        theme.Set(ImGuiCol_Text,                          ImVec4(0.00f, 0.82f, 1.00f, 1.00f));
+        theme.Set(ImGuiCol_TextDisabled,                  ImVec4(0.00f, 0.36f, 0.63f, 1.00f));
+        theme.Set(ImGuiCol_WindowBg,                      ImVec4(0.00f, 0.04f, 0.12f, 1.00f));
+        theme.Set(ImGuiCol_ChildBg,                       ImVec4(0.03f, 0.04f, 0.22f, 1.00f));
+        theme.Set(ImGuiCol_PopupBg,                       ImVec4(0.12f, 0.06f, 0.27f, 1.00f));
+        theme.Set(ImGuiCol_Border,                        ImVec4(0.61f, 0.00f, 1.00f, 1.00f));
+        theme.Set(ImGuiCol_FrameBg,                       ImVec4(0.00f, 0.75f, 1.00f, 0.20f));
+        theme.Set(ImGuiCol_FrameBgHovered,                ImVec4(0.34f, 0.00f, 1.00f, 1.00f));
+        theme.Set(ImGuiCol_FrameBgActive,                 ImVec4(0.08f, 0.00f, 1.00f, 1.00f));
+        theme.Set(ImGuiCol_TitleBg,                       ImVec4(0.00f, 0.81f, 0.95f, 1.00f));
+        theme.Set(ImGuiCol_TitleBgActive,                 ImVec4(0.61f, 0.00f, 1.00f, 1.00f));
+        theme.Set(ImGuiCol_TitleBgCollapsed,              ImVec4(0.25f, 0.00f, 0.54f, 0.81f));
+        theme.Set(ImGuiCol_MenuBarBg,                     ImVec4(0.61f, 0.00f, 1.00f, 1.00f));
+        theme.Set(ImGuiCol_ScrollbarBg,                   ImVec4(0.00f, 0.88f, 1.00f, 1.00f));
+        theme.Set(ImGuiCol_ScrollbarGrab,                 ImVec4(0.61f, 0.00f, 1.00f, 1.00f));
+        theme.Set(ImGuiCol_ScrollbarGrabHovered,          ImVec4(0.01f, 0.00f, 1.00f, 1.00f));
+        theme.Set(ImGuiCol_ScrollbarGrabActive,           ImVec4(0.95f, 0.19f, 0.67f, 1.00f));
+        theme.Set(ImGuiCol_CheckMark,                     ImVec4(0.95f, 0.19f, 0.92f, 1.00f));
+        theme.Set(ImGuiCol_SliderGrab,                    ImVec4(0.00f, 1.00f, 0.95f, 1.00f));
+        theme.Set(ImGuiCol_SliderGrabActive,              ImVec4(0.81f, 0.00f, 1.00f, 1.00f));
+        theme.Set(ImGuiCol_Button,                        ImVec4(0.00f, 0.98f, 1.00f, 0.52f));
+        theme.Set(ImGuiCol_ButtonHovered,                 ImVec4(0.94f, 0.00f, 1.00f, 0.80f));
+        theme.Set(ImGuiCol_ButtonActive,                  ImVec4(0.01f, 0.00f, 1.00f, 1.00f));
+        theme.Set(ImGuiCol_Header,                        ImVec4(0.00f, 0.95f, 1.00f, 0.40f));
+        theme.Set(ImGuiCol_HeaderHovered,                 ImVec4(0.94f, 0.00f, 1.00f, 0.80f));
+        theme.Set(ImGuiCol_HeaderActive,                  ImVec4(0.01f, 0.00f, 1.00f, 1.00f));
+        theme.Set(ImGuiCol_Separator,                     ImVec4(0.74f, 0.00f, 1.00f, 0.50f));
+        theme.Set(ImGuiCol_SeparatorHovered,              ImVec4(0.34f, 0.00f, 1.00f, 0.78f));
+        theme.Set(ImGuiCol_SeparatorActive,               ImVec4(0.00f, 1.00f, 0.85f, 1.00f));
+        theme.Set(ImGuiCol_ResizeGrip,                    ImVec4(0.61f, 0.00f, 1.00f, 1.00f));
+        theme.Set(ImGuiCol_ResizeGripHovered,             ImVec4(0.89f, 0.26f, 0.98f, 0.67f));
+        theme.Set(ImGuiCol_ResizeGripActive,              ImVec4(0.00f, 0.88f, 1.00f, 0.95f));
+        theme.Set(ImGuiCol_Tab,                           ImVec4(0.36f, 0.00f, 1.00f, 1.00f));
+        theme.Set(ImGuiCol_TabHovered,                    ImVec4(0.00f, 0.92f, 1.00f, 0.80f));
+        theme.Set(ImGuiCol_TabActive,                     ImVec4(0.62f, 0.00f, 0.80f, 1.00f));
+        theme.Set(ImGuiCol_PlotHistogram,                 ImVec4(0.00f, 1.00f, 0.88f, 1.00f));
+        theme.Set(&ImGuiStyle::FrameBorderSize,           0.00f);
+        theme.Set(&ImGuiStyle::WindowRounding,            0.00f);
+        theme.Set(&ImGuiStyle::FrameRounding,             0.00f);
+        theme.Set(&ImGuiStyle::ScrollbarRounding,         0.00f);
+        theme.Set(&ImGuiStyle::GrabRounding,              0.00f);
+        return theme;
+      }
+
+      IMCANDY_API void Theme_Cyberpunk(ImGuiStyle* dst = NULL);
+
+      // Nord/Nordic GTK [Improvised]
+      // https://github.com/EliverLara/Nordic
+      inline IMCANDY_CONSTEXPR14 Theme MakeTheme_Nord()
+      {
+        Theme theme = MakeTheme_Dark();
+        theme.Set(ImGuiCol_Text,                          ImVec4(0.85f, 0.87f, 0.91f, 0.88f));
+        theme.Set(ImGuiCol_TextDisabled,                  ImVec4(0.49f, 0.50f, 0.53f, 1.00f));
+        theme.Set(ImGuiCol_WindowBg,                      ImVec4(0.18f, 0.20f, 0.25f, 1.00f));
+        theme.Set(ImGuiCol_ChildBg,                       ImVec4(0.16f, 0.17f, 0.20f, 1.00f));
+        theme.Set(ImGuiCol_PopupBg,                       ImVec4(0.23f, 0.26f, 0.32f, 1.00f));
+        theme.Set(ImGuiCol_Border,                        ImVec4(0.14f, 0.16f, 0.19f, 1.00f));
+        theme.Set(ImGuiCol_BorderShadow,                  ImVec4(0.09f, 0.09f, 0.09f, 0.00f));
+        theme.Set(ImGuiCol_FrameBg,                       ImVec4(0.23f, 0.26f, 0.32f, 1.00f));
+        theme.Set(ImGuiCol_FrameBgHovered,                ImVec4(0.56f, 0.74f, 0.73f, 1.00f));
+        theme.Set(ImGuiCol_FrameBgActive,                 ImVec4(0.53f, 0.75f, 0.82f, 1.00f));
+        theme.Set(ImGuiCol_TitleBg,                       ImVec4(0.16f, 0.16f, 0.20f, 1.00f));
+        theme.Set(ImGuiCol_TitleBgActive,                 ImVec4(0.16f, 0.16f, 0.20f, 1.00f));
+        theme.Set(ImGuiCol_TitleBgCollapsed,              ImVec4(0.16f, 0.16f, 0.20f, 1.00f));
+        theme.Set(ImGuiCol_MenuBarBg,                     ImVec4(0.16f, 0.16f, 0.20f, 1.00f));
+        theme.Set(ImGuiCol_ScrollbarBg,                   ImVec4(0.18f, 0.20f, 0.25f, 1.00f));
+        theme.Set(ImGuiCol_ScrollbarGrab,                 ImVec4(0.23f, 0.26f, 0.32f, 0.60f));
+        theme.Set(ImGuiCol_ScrollbarGrabHovered,          ImVec4(0.23f, 0.26f, 0.32f, 1.00f));
+        theme.Set(ImGuiCol_ScrollbarGrabActive,           ImVec4(0.23f, 0.26f, 0.32f, 1.00f));
+        theme.Set(ImGuiCol_CheckMark,                     ImVec4(0.37f, 0.51f, 0.67f, 1.00f));
+        theme.Set(ImGuiCol_SliderGrab,                    ImVec4(0.51f, 0.63f, 0.76f, 1.00f));
+        theme.Set(ImGuiCol_SliderGrabActive,              ImVec4(0.37f, 0.51f, 0.67f, 1.00f));
+        theme.Set(ImGuiCol_Button,                        ImVec4(0.18f, 0.20f, 0.25f, 1.00f));
+        theme.Set(ImGuiCol_ButtonHovered,                 ImVec4(0.51f, 0.63f, 0.76f, 1.00f));
+        theme.Set(ImGuiCol_ButtonActive,                  ImVec4(0.37f, 0.51f, 0.67f, 1.00f));
+        theme.Set(ImGuiCol_Header,                        ImVec4(0.51f, 0.63f, 0.76f, 1.00f));
+        theme.Set(ImGuiCol_HeaderHovered,                 ImVec4(0.53f, 0.75f, 0.82f, 1.00f));
+        theme.Set(ImGuiCol_HeaderActive,                  ImVec4(0.37f, 0.51f, 0.67f, 1.00f));
+        theme.Set(ImGuiCol_SeparatorHovered,              ImVec4(0.56f, 0.74f, 0.73f, 1.00f));
+        theme.Set(ImGuiCol_SeparatorActive,               ImVec4(0.53f, 0.75f, 0.82f, 1.00f));
+        theme.Set(ImGuiCol_ResizeGrip,                    ImVec4(0.53f, 0.75f, 0.82f, 0.86f));
+        theme.Set(ImGuiCol_ResizeGripHovered,             ImVec4(0.61f, 0.74f, 0.87f, 1.00f));
+        theme.Set(ImGuiCol_ResizeGripActive,              ImVec4(0.37f, 0.51f, 0.67f, 1.00f));
+        theme.Set(ImGuiCol_Tab,                           ImVec4(0.18f, 0.20f, 0.25f, 1.00f));
+        theme.Set(ImGuiCol_TabHovered,                    ImVec4(0.22f, 0.24f, 0.31f, 1.00f));
+        theme.Set(ImGuiCol_TabActive,                     ImVec4(0.23f, 0.26f, 0.32f, 1.00f));
+        theme.Set(ImGuiCol_TabUnfocused,                  ImVec4(0.13f, 0.15f, 0.18f, 1.00f));
+        theme.Set(ImGuiCol_TabUnfocusedActive,            ImVec4(0.17f, 0.19f, 0.23f, 1.00f));
+        theme.Set(ImGuiCol_PlotHistogram,                 ImVec4(0.56f, 0.74f, 0.73f, 1.00f));
+        theme.Set(ImGuiCol_PlotHistogramHovered,          ImVec4(0.53f, 0.75f, 0.82f, 1.00f));
+        theme.Set(ImGuiCol_TextSelectedBg,                ImVec4(0.37f, 0.51f, 0.67f, 1.00f));
+        theme.Set(ImGuiCol_NavHighlight,                  ImVec4(0.53f, 0.75f, 0.82f, 0.86f));
+        theme.Set(&ImGuiStyle::WindowBorderSize,          1.00f);
+        theme.Set(&ImGuiStyle::ChildBorderSize,           1.00f);
+        theme.Set(&ImGuiStyle::PopupBorderSize,           1.00f);
+        theme.Set(&ImGuiStyle::FrameBorderSize,           1.00f);
+        return theme;
+      }
+
+      IMCANDY_API void Theme_Nord(ImGuiStyle* dst = NULL);
+
+      /*
+      Theme registry: every theme is built once into a complete ImGuiStyle, so switching is a single copy.
+      Themes are found by name or by the ImGuiID returned from Register(). A snapshot replaces the whole
+      style (sizes included), register a theme on top of your own base style to keep your sizes.
+      Each ImGuiContext can override the default theme, ApplyContextTheme() only copies when it changed.
+      ---------------------------------------------------------------
+        ImCandy::ThemeRegistry& themes = ImCandy::GetThemeRegistry();
+        themes.Apply("Nord");
+
+        // Per context, e.g. once per frame for each window of a multi-viewport/multi-context app
+        themes.SetContextTheme(ctx, themes.FindID("Cyberpunk"));
+        ImGui::SetCurrentContext(ctx);
+        themes.ApplyContextTheme();
+      ---------------------------------------------------------------
+      */
+
+      class ThemeRegistry
+      {
+      public:
+          // 'base' provides the sizes and any color the theme leaves alone, ImGuiStyle() when NULL
+          ImGuiID Register(const char* name, const Theme& theme, const ImGuiStyle* base = NULL)
+          {
+              ImGuiStyle style = base ? *base : ImGuiStyle();
+              ApplyTheme(theme, &style);
+              return Register(name, style);
+          }
+
+          // Registering a name again replaces its snapshot
+          ImGuiID Register(const char* name, const ImGuiStyle& style)
+          {
+              const ImGuiID id = HashName(name);
+              Entry* it = LowerBound(id);
+              if (it == Entries.end() || it->ID != id)
+              {
+                  Entry entry;
+                  entry.ID = id;
+                  it = Entries.insert(it, entry);
+              }
+              strncpy(it->Name, name, sizeof(it->Name) - 1);
+              it->Name[sizeof(it->Name) - 1] = '\0';
+              it->Style = style;
+              Version++;
+              return id;
+          }
+
+          ImGuiID FindID(const char* name) const { return Find(HashName(name)) ? HashName(name) : 0; }
+
+          // The pointer stays valid until the next Register()
+          const ImGuiStyle* Find(ImGuiID id) const
+          {
+              const Entry* it = LowerBound(id);
+              return it != Entries.end() && it->ID == id ? &it->Style : NULL;
+          }
+          const ImGuiStyle* Find(const char* name) const { return Find(HashName(name)); }
+
+          // Sorted by ID, not by registration order
+          int GetCount() const { return Entries.Size; }
+          const char* GetName(int i) const { return Entries[i].Name; }
+          ImGuiID GetID(int i) const { return Entries[i].ID; }
+
+          bool Apply(ImGuiID id, ImGuiStyle* dst = NULL) const
+          {
+              IMCANDY_METRICS_SCOPE(ApplyTheme, 1);
+              const ImGuiStyle* style = Find(id);
+              if (!style)
+                  return false;
+              *(dst ? dst : &ImGui::GetStyle()) = *style;
+              return true;
+          }
+          bool Apply(const char* name, ImGuiStyle* dst = NULL) const { return Apply(HashName(name), dst); }
+
+          // Theme used by contexts without an override, 0 leaves their style alone
+          void SetDefaultTheme(ImGuiID id) { DefaultTheme = id; }
+          ImGuiID GetDefaultTheme() const { return DefaultTheme; }
+
+          // 0 removes the override
+          void SetContextTheme(ImGuiContext* ctx, ImGuiID id)
+          {
+              for (int i = 0; i < Contexts.Size; i++)
+                  if (Contexts[i].Context == ctx)
+                  {
+                      Contexts[i].Theme = id;
+                      return;
+                  }
+              ContextEntry entry = { ctx, id, 0, 0 };
+              Contexts.push_back(entry);
+          }
+
+          ImGuiID GetContextTheme(ImGuiContext* ctx) const
+          {
+              for (int i = 0; i < Contexts.Size; i++)
+                  if (Contexts[i].Context == ctx && Contexts[i].Theme != 0)
+                      return Contexts[i].Theme;
+              return DefaultTheme;
+          }
+
+          // Call when a context is destroyed
+          void RemoveContext(ImGuiContext* ctx)
+          {
+              for (int i = 0; i < Contexts.Size; i++)
+                  if (Contexts[i].Context == ctx)
+                  {
+                      Contexts.erase(Contexts.Data + i);
+                      return;
+                  }
+          }
+
+          // Copies the theme of the current context into its style, unless it is already there.
+          // Pass force = true after changing that style by other means.
+          bool ApplyContextTheme(bool force = false)
+          {
+              ImGuiContext* ctx = ImGui::GetCurrentContext();
+              const ImGuiID id = GetContextTheme(ctx);
+              if (id == 0)
+                  return false;
+
+              ContextEntry* entry = NULL;
+              for (int i = 0; i < Contexts.Size && !entry; i++)
+                  if (Contexts[i].Context == ctx)
+                      entry = &Contexts[i];
+              if (!entry)
+              {
+                  ContextEntry new_entry = { ctx, 0, 0, 0 };
+                  Contexts.push_back(new_entry);
+                  entry = &Contexts.back();
+              }
+
+              if (!force && entry->Applied == id && entry->AppliedVersion == Version)
+              {
+                  IMCANDY_METRICS_HITS(ApplyTheme, 1);
+                  return false;
+              }
+              if (!Apply(id))
+                  return false;
+              entry->Applied = id;
+              entry->AppliedVersion = Version;
+              return true;
+          }
+
+          // FNV-1a, the ID of a name is the same in every registry
+          static ImGuiID HashName(const char* name)
+          {
+              ImU32 hash = 2166136261u;
+              for (const unsigned char* c = (const unsigned char*)name; *c; c++)
+                  hash = (hash ^ *c) * 16777619u;
+              return hash ? hash : 1;
+          }
+
+      private:
+          struct Entry
+          {
+              ImGuiID ID;
+              char Name[32];
+              ImGuiStyle Style;
+          };
+
+          struct ContextEntry
+          {
+              ImGuiContext* Context;
+              ImGuiID Theme;          // 0 = default theme
+              ImGuiID Applied;
+              int AppliedVersion;
+          };
+
+          Entry* LowerBound(ImGuiID id)
+          {
+              return const_cast<Entry*>(static_cast<const ThemeRegistry*>(this)->LowerBound(id));
+          }
+
+          const Entry* LowerBound(ImGuiID id) const
+          {
+              const Entry* first = Entries.begin();
+              int count = Entries.Size;
+              while (count > 0)
+              {
+                  const int half = count / 2;
+                  if (first[half].ID < id)
+                  {
+                      first += half + 1;
+                      count -= half + 1;
+                  }
+                  else
+                      count = half;
+              }
+              return first;
+          }
+
+          ImVector<Entry> Entries;
+          ImVector<ContextEntry> Contexts;
+          ImGuiID DefaultTheme = 0;
+          int Version = 0;
+      };
+
+      /*
+      Cross-fade between two styles: colors are blended as one contiguous float array, the rounding,
+      padding and border fields through a table of pointers to members. Once the fade is over Update()
+      returns right away. Starting a new fade midway continues from the style currently shown.
+      ---------------------------------------------------------------
+        static ImCandy::StyleTransition fade;
+        if (ImGui::Button("Nord"))
+            fade.Start(*ImCandy::GetThemeRegistry().Find("Nord"), 0.3f);
+        fade.Update(); // before ImGui::NewFrame() or at least before drawing
+      ---------------------------------------------------------------
+      */
+
+      namespace detail
+      {
+          struct StyleFloatField { const char* Name; float ImGuiStyle::* Field; };
+          struct StyleVec2Field  { const char* Name; ImVec2 ImGuiStyle::* Field; };
+
+          // Style fields shared by every Dear ImGui version candy.h supports, blended by StyleTransition
+          // and read/written by theme files. Function-local so every translation unit sees the same table.
+          inline const StyleFloatField* StyleFloatFields(int* count)
+          {
+              static const StyleFloatField fields[] =
+              {
+                  { "Alpha", &ImGuiStyle::Alpha },                         { "WindowRounding", &ImGuiStyle::WindowRounding },
+                  { "WindowBorderSize", &ImGuiStyle::WindowBorderSize },   { "ChildRounding", &ImGuiStyle::ChildRounding },
+                  { "ChildBorderSize", &ImGuiStyle::ChildBorderSize },     { "PopupRounding", &ImGuiStyle::PopupRounding },
+                  { "PopupBorderSize", &ImGuiStyle::PopupBorderSize },     { "FrameRounding", &ImGuiStyle::FrameRounding },
+                  { "FrameBorderSize", &ImGuiStyle::FrameBorderSize },     { "IndentSpacing", &ImGuiStyle::IndentSpacing },
+                  { "ColumnsMinSpacing", &ImGuiStyle::ColumnsMinSpacing }, { "ScrollbarSize", &ImGuiStyle::ScrollbarSize },
+                  { "ScrollbarRounding", &ImGuiStyle::ScrollbarRounding }, { "GrabMinSize", &ImGuiStyle::GrabMinSize },
+                  { "GrabRounding", &ImGuiStyle::GrabRounding },           { "TabRounding", &ImGuiStyle::TabRounding },
+                  { "TabBorderSize", &ImGuiStyle::TabBorderSize },
+              };
+              *count = int(sizeof(fields) / sizeof(fields[0]));
+              return fields;
+          }
+
+          inline const StyleVec2Field* StyleVec2Fields(int* count)
+          {
+              static const StyleVec2Field fields[] =
+              {
+                  { "WindowPadding", &ImGuiStyle::WindowPadding },         { "WindowMinSize", &ImGuiStyle::WindowMinSize },
+                  { "WindowTitleAlign", &ImGuiStyle::WindowTitleAlign },   { "FramePadding", &ImGuiStyle::FramePadding },
+                  { "ItemSpacing", &ImGuiStyle::ItemSpacing },             { "ItemInnerSpacing", &ImGuiStyle::ItemInnerSpacing },
+                  { "CellPadding", &ImGuiStyle::CellPadding },             { "TouchExtraPadding", &ImGuiStyle::TouchExtraPadding },
+                  { "ButtonTextAlign", &ImGuiStyle::ButtonTextAlign },     { "SelectableTextAlign", &ImGuiStyle::SelectableTextAlign },
+              };
+              *count = int(sizeof(fields) / sizeof(fields[0]));
+              return fields;
+          }
+      }
+
+      class StyleTransition
+      {
+      public:
+          // Fades from 'from' (the current style when NULL) to 'to' over 'duration' seconds
+          void Start(const ImGuiStyle& to, float duration = 0.25f, const ImGuiStyle* from = NULL)
+          {
+              From = from ? *from : ImGui::GetStyle();
+              To = to;
+              Duration = duration;
+              Elapsed = 0.0f;
+              Active = true;
+              Started = false;
+          }
+
+          // Advances by io.DeltaTime and writes the blended style into dst (the current style when NULL).
+          // Returns false, without touching dst, when no fade is running.
+          bool Update(ImGuiStyle* dst = NULL)
+          {
+              if (!Active)
+                  return false;
+
+              IMCANDY_METRICS_SCOPE(StyleTransition, ImGuiCol_COUNT);
+              ImGuiStyle* style = dst ? dst : &ImGui::GetStyle();
+              Elapsed += ImGui::GetIO().DeltaTime;
+              if (Elapsed >= Duration)
+              {
+                  *style = To;
+                  Active = false;
+                  return true;
+              }
+
+              // Fields that are not blended switch at the start
+              if (!Started)
+              {
+                  *style = To;
+                  Started = true;
+              }
+
+              const float t = gradient::smoothstep_interpolation(Elapsed / Duration);
+              gradient::detail::lerp_colors(&From.Colors[0].x, &To.Colors[0].x, t, ImGuiCol_COUNT, &style->Colors[0].x);
+
+              int count = 0;
+              const detail::StyleFloatField* floats = detail::StyleFloatFields(&count);
+              for (int i = 0; i < count; i++)
+              {
+                  float ImGuiStyle::* field = floats[i].Field;
+                  style->*field = From.*field + (To.*field - From.*field) * t;
+              }
+              const detail::StyleVec2Field* vec2s = detail::StyleVec2Fields(&count);
+              for (int i = 0; i < count; i++)
+              {
+                  ImVec2 ImGuiStyle::* field = vec2s[i].Field;
+                  style->*field = ImVec2((From.*field).x + ((To.*field).x - (From.*field).x) * t,
+                                         (From.*field).y + ((To.*field).y - (From.*field).y) * t);
+              }
+              return true;
+          }
+
+          // Jumps to the target style
+          void Finish(ImGuiStyle* dst = NULL)
+          {
+              if (!Active)
+                  return;
+              *(dst ? dst : &ImGui::GetStyle()) = To;
+              Active = false;
+          }
+
+          bool IsActive() const { return Active; }
+          float GetProgress() const { return Active ? Elapsed / Duration : 1.0f; }
+
+      private:
+          ImGuiStyle From, To;
+          float Duration = 0.0f;
+          float Elapsed = 0.0f;
+          bool Active = false;
+          bool Started = false;
+      };
+
+      // Registry holding the built-in themes: "Dark", "Blender", "Cyberpunk" and "Nord"
+      IMCANDY_API ThemeRegistry& GetThemeRegistry();
+
+      /*---------------------------------------------------------------------------------------------------------
+                                                       BINDINGS                                                */
+
+      /*
+      Style bindings: animated colors declared once instead of a Gradient2() + PushStyleColor() pair per widget.
+      A binding maps an ImGuiCol_ slot, or a named role read by your own widgets, to a gradient cycling like
+      Animator::Animate(). The stops of every binding share one array, so UpdateBindings() evaluates all of
+      them in a single batched lerp and copies the slot colors into the style.
+      ---------------------------------------------------------------
+        // Once
+        ImCandy::StyleBindings& bindings = ImCandy::GetStyleBindings();
+        bindings.Bind(ImGuiCol_Border, ImCandy::RainbowGradient(), 0.6f);
+        bindings.Bind("accent", ImCandy::Gradient<3>{{ IV4_VIOLET, IV4_BUBBLEGUM, IV4_VIOLET }}, 0.3f);
+
+        // Every frame, after ImGui::NewFrame()
+        ImCandy::UpdateBindings();
+        ...
+        ImGui::PushStyleColor(ImGuiCol_Button, bindings.GetColor("accent"));
+      ---------------------------------------------------------------
+      Without UpdateBindings(), Update() then PushColors() / PopColors() scope the slot colors to some widgets.
+      */
+      class StyleBindings
+      {
+      public:
+          // Caps how often the colors change: time is quantized to 1 / MaxFPS seconds (0 = no cap)
+          float MaxFPS = 0.0f;
+
+          // Binds a style color, replacing its previous binding.
+          // One cycle runs through the whole gradient, phase is an offset in cycles.
+          template<int N>
+          void Bind(ImGuiCol idx, const Gradient<N>& gradient, float cycles_per_second, float phase = 0.0f)
+          {
+              IM_ASSERT(idx >= 0 && idx < ImGuiCol_COUNT);
+              Add(idx, 0, gradient.Stops, N, cycles_per_second, phase);
+          }
+
+          // Binds a named role, GetColor(role) reads it
+          template<int N>
+          void Bind(const char* role, const Gradient<N>& gradient, float cycles_per_second, float phase = 0.0f)
+          {
+              Add(-1, ThemeRegistry::HashName(role), gradient.Stops, N, cycles_per_second, phase);
+          }
+
+          void Unbind(ImGuiCol idx) { Remove(idx, 0); }
+          void Unbind(const char* role) { Remove(-1, ThemeRegistry::HashName(role)); }
+
+          void Clear()
+          {
+              Bindings.clear();
+              Stops.clear();
+              Colors.clear();
+              Frame = -1;
+          }
+
+          int GetCount() const { return Bindings.Size; }
+
+          // Evaluates every binding for the current frame, later calls in the same frame do nothing
+          void Update()
+          {
+              const int frame = ImGui::GetFrameCount();
+              if (frame == Frame)
+                  return;
+              Frame = frame;
+              IMCANDY_METRICS_SCOPE(Bindings, Bindings.Size);
+
+              double time = ImGui::GetTime();
+              if (MaxFPS > 0.0f)
+                  time = floor(time * MaxFPS) / MaxFPS;
+
+              const int count = Bindings.Size;
+              Lo.resize(count);
+              Hi.resize(count);
+              T.resize(count);
+              Colors.resize(count);
+              for (int i = 0; i < count; i++)
+              {
+                  const Binding& binding = Bindings[i];
+                  double cycle = time * binding.CyclesPerSecond + binding.Phase;
+                  cycle -= floor(cycle);
+
+                  const double ratio = cycle * (binding.StopCount - 1);
+                  const int stop = std::min(int(ratio), binding.StopCount - 2);
+                  Lo[i] = std::uint32_t(binding.FirstStop + stop);
+                  Hi[i] = Lo[i] + 1;
+                  T[i] = float(ratio - stop);
+              }
+              if (count > 0)
+                  gradient::detail::lerp_rgba(&Stops[0].x, Lo.Data, Hi.Data, T.Data, std::size_t(count), &Colors[0].x);
+          }
+
+          // Writes the slot colors into dst (the current style when NULL)
+          void Apply(ImGuiStyle* dst = NULL) const
+          {
+              ImGuiStyle* style = dst ? dst : &ImGui::GetStyle();
+              for (int i = 0; i < Colors.Size; i++)
+                  if (Bindings[i].Target >= 0)
+                      style->Colors[Bindings[i].Target] = Colors[i];
+          }
+
+          // Pushes the slot colors with ImGui::PushStyleColor(), PopColors() pops them
+          void PushColors()
+          {
+              for (int i = 0; i < Colors.Size; i++)
+                  if (Bindings[i].Target >= 0)
+                  {
+                      ImGui::PushStyleColor(Bindings[i].Target, Colors[i]);
+                      Pushed++;
+                  }
+          }
+
+          // Pushes the color of a role onto a slot, PopColors() pops it too
+          void PushColor(ImGuiCol idx, const char* role)
+          {
+              ImGui::PushStyleColor(idx, GetColor(role));
+              Pushed++;
+          }
+
+          void PopColors()
+          {
+              ImGui::PopStyleColor(Pushed);
+              Pushed = 0;
+          }
+
+          // Color of a slot or role as of the last Update(), transparent black when unbound
+          ImVec4 GetColor(ImGuiCol idx) const { return FindColor(idx, 0); }
+          ImVec4 GetColor(const char* role) const { return FindColor(-1, ThemeRegistry::HashName(role)); }
+
+          // Like Animator::GetTimeUntilNextChange(), for the bound colors: bindings animate until unbound
+          float GetTimeUntilNextChange() const
+          {
+              float rate = 0.0f;
+              for (int i = 0; i < Bindings.Size; i++)
+                  rate = std::max(rate, Bindings[i].Rate);
+              return detail::TimeUntilNextChange(rate, MaxFPS, ImGui::GetTime());
+          }
+
+      private:
+          struct Binding
+          {
+              ImGuiCol Target;          // -1 for a role
+              ImGuiID  Role;
+              int      FirstStop;
+              int      StopCount;
+              float    CyclesPerSecond;
+              float    Phase;
+              float    Rate;            // Max color change per second, in 0-1 units
+          };
+
+          ImVector<Binding> Bindings;
+          ImVector<ImVec4>  Stops;          // Stops of every binding, back to back
+          ImVector<ImVec4>  Colors;         // Parallel to Bindings, written by Update()
+          ImVector<std::uint32_t> Lo, Hi;   // Update() scratch
+          ImVector<float>   T;
+          int Frame = -1;
+          int Pushed = 0;
+
+          int FindBinding(ImGuiCol target, ImGuiID role) const
+          {
+              for (int i = 0; i < Bindings.Size; i++)
+                  if (Bindings[i].Target == target && Bindings[i].Role == role)
+                      return i;
+              return -1;
+          }
+
+          void Add(ImGuiCol target, ImGuiID role, const ImVec4* stops, int count, float cycles_per_second, float phase)
+          {
+              Remove(target, role);
+              Binding binding = { target, role, Stops.Size, count, cycles_per_second, phase, detail::CycleRate(stops, count, cycles_per_second) };
+              for (int i = 0; i < count; i++)
+                  Stops.push_back(stops[i]);
+              Bindings.push_back(binding);
+              Frame = -1;
+          }
+
+          void Remove(ImGuiCol target, ImGuiID role)
+          {
+              const int index = FindBinding(target, role);
+              if (index < 0)
+                  return;
+
+              const Binding removed = Bindings[index];
+              Stops.erase(Stops.begin() + removed.FirstStop, Stops.begin() + removed.FirstStop + removed.StopCount);
+              Bindings.erase(Bindings.begin() + index);
+              if (index < Colors.Size)
+                  Colors.erase(Colors.begin() + index);
+              for (int i = 0; i < Bindings.Size; i++)
+                  if (Bindings[i].FirstStop > removed.FirstStop)
+                      Bindings[i].FirstStop -= removed.StopCount;
+              Frame = -1;
+          }
+
+          ImVec4 FindColor(ImGuiCol target, ImGuiID role) const
+          {
+              const int index = FindBinding(target, role);
+              return index >= 0 && index < Colors.Size ? Colors[index] : ImVec4(0.0f, 0.0f, 0.0f, 0.0f);
+          }
+      };
+
+      // Shared bindings, evaluated by UpdateBindings()
+      IMCANDY_API StyleBindings& GetStyleBindings();
+
+      // Evaluates the shared bindings once per frame and writes their slot colors into dst (the current style when NULL)
+      IMCANDY_API void UpdateBindings(ImGuiStyle* dst = NULL);
+
+      // Smaller of GetAnimator().GetTimeUntilNextChange() and GetStyleBindings().GetTimeUntilNextChange():
+      // how long a host that only renders on input can sleep without missing a color step of either
+      IMCANDY_API float GetTimeUntilNextChange();
+
+      /*---------------------------------------------------------------------------------------------------------
+                                                        METRICS                                                */
+
+      /*
+      Define IMCANDY_ENABLE_METRICS project-wide to count, per frame, the calls, evaluated colors, heap
+      allocations, cache/table hits and time of each ImCandy API (see metrics.h). Without it the hooks compile
+      to nothing and the window only says so.
+      ---------------------------------------------------------------
+        ImCandy::ShowMetricsWindow();
+        const ImCandy::MetricsStats& batch = ImCandy::GetMetrics().GetFrame(ImCandy::MetricsCounter_GradientBatch);
+      ---------------------------------------------------------------
+      */
+
+      // Last frame's counters plus rolling histograms, also ends the frame of the counters (Metrics::NextFrame())
+      IMCANDY_API void ShowMetricsWindow(bool* p_open = NULL);
+
+      /*---------------------------------------------------------------------------------------------------------
+                                                        WIDGETS                                                */
+
+      /*
+      Color ramp editor for a gradient.h gradient of gradient::Color4 stops (LinearColor4Gradient,
+      FlatLinearColor4Gradient...). Click the bar to add a stop, drag a marker to move it, double-click a
+      marker to remove it, the selected stop gets a color picker. Every edit goes through the gradient's
+      change tracking, so the editor's own table and anything synced with update() / UpdateMap() only
+      re-sample the segments next to the edited stop.
+      ---------------------------------------------------------------
+        static gradient::FlatLinearColor4Gradient ramp; // with at least two stops
+        static ImCandy::GradientEditor<gradient::FlatLinearColor4Gradient> editor(4096);
+        if (editor.Draw("Heat", ramp))
+            heatmap.UpdateMap(ramp);
+        draw_list->AddRectFilled(p_min, p_max, editor.GetBaked().lerp(0.5f));
+      ---------------------------------------------------------------
+      */
+      template<typename G>
+      class GradientEditor
+      {
+      public:
+          typedef typename G::key_type Key;
+
+          // resolution = entries of the table kept in sync with the gradient, 0 for none
+          explicit GradientEditor(int resolution = 0) : Resolution(resolution) {}
+
+          // Returns true when the gradient changed
+          bool Draw(const char* label, G& gradient, float height = 0.0f)
+          {
+              IM_ASSERT(gradient.size() >= 2);
+              ImGui::PushID(label);
+
+              const float width = ImGui::CalcItemWidth();
+              const float bar_height = height > 0.0f ? height : ImGui::GetFrameHeight() * 1.5f;
+              const float marker_size = ImGui::GetFrameHeight() * 0.5f;
+              const ImVec2 p_min = ImGui::GetCursorScreenPos();
+              const ImVec2 bar_max(p_min.x + width, p_min.y + bar_height);
+
+              ImGui::InvisibleButton("##ramp", ImVec2(width, bar_height + marker_size));
+              bool changed = false;
+
+              // The selected stop may have been removed by other code
+              if (HasSelection)
+              {
+                  bool found = false;
+                  gradient.forEachKey([&](Key key) { found = found || key == Selected; });
+                  HasSelection = found;
+                  Dragging = Dragging && found;
+              }
+
+              // Key range at the start of a drag, so moving an end stop does not rescale the bar under the mouse
+              if (!Dragging)
+              {
+                  RangeFirst = gradient.firstKey();
+                  RangeLast = gradient.lastKey();
+              }
+              const float mouse_x = ImGui::GetMousePos().x;
+              Key mouse_key = Key(RangeFirst + (RangeLast - RangeFirst) * Saturate((mouse_x - p_min.x) / width));
+
+              if (ImGui::IsItemActivated())
+              {
+                  Key hit = 0;
+                  if (FindMarker(gradient, p_min.x, width, mouse_x, marker_size * 0.5f, &hit))
+                  {
+                      if (ImGui::IsMouseDoubleClicked(0) && gradient.size() > 2)
+                      {
+                          gradient.erase(hit);
+                          HasSelection = false;
+                          changed = true;
+                      }
+                      else
+                      {
+                          Selected = hit;
+                          HasSelection = Dragging = true;
+                      }
+                  }
+                  else if (ImGui::GetMousePos().y < bar_max.y)
+                  {
+                      const gradient::Color4 color = gradient(mouse_key);
+                      gradient.set(mouse_key, color);
+                      Selected = mouse_key;
+                      HasSelection = Dragging = true;
+                      changed = true;
+                  }
+              }
+
+              if (Dragging && !ImGui::IsItemActive())
+                  Dragging = false;
+              if (Dragging && HasSelection && mouse_key != Selected && gradient.move(Selected, mouse_key))
+              {
+                  Selected = mouse_key;
+                  changed = true;
+              }
+
+              if (Resolution > 0)
+              {
+                  if (Baked.empty() || Baked.firstKey() != gradient.firstKey() || Baked.lastKey() != gradient.lastKey())
+                      Baked.bake(gradient, size_t(Resolution));
+                  else
+                      Baked.update(gradient);
+              }
+
+              // Bar and markers
+              ImDrawList* draw_list = ImGui::GetWindowDrawList();
+              const Key first = gradient.firstKey(), last = gradient.lastKey();
+              const float bar_x0 = p_min.x + width * float((first - RangeFirst) / (RangeLast - RangeFirst));
+              const float bar_x1 = p_min.x + width * float((last - RangeFirst) / (RangeLast - RangeFirst));
+              DrawGradientRect(draw_list, ImVec2(bar_x0, p_min.y), ImVec2(bar_x1, bar_max.y), gradient);
+              draw_list->AddRect(p_min, bar_max, ImGui::GetColorU32(ImGuiCol_Border));
+
+              const G& stops = gradient;
+              gradient.forEachKey([&](Key key)
+              {
+                  const float x = p_min.x + width * float((key - RangeFirst) / (RangeLast - RangeFirst));
+                  const bool selected = HasSelection && key == Selected;
+                  const ImU32 outline = ImGui::GetColorU32(selected ? ImGuiCol_Text : ImGuiCol_Border);
+                  draw_list->AddTriangleFilled(ImVec2(x, bar_max.y), ImVec2(x - marker_size * 0.5f, bar_max.y + marker_size * 0.5f),
+                                               ImVec2(x + marker_size * 0.5f, bar_max.y + marker_size * 0.5f), outline);
+                  const ImVec2 box_min(x - marker_size * 0.5f, bar_max.y + marker_size * 0.5f), box_max(x + marker_size * 0.5f, bar_max.y + marker_size);
+                  draw_list->AddRectFilled(box_min, box_max, ImGui::ColorConvertFloat4ToU32(ToImVec4(stops[key])));
+                  draw_list->AddRect(box_min, box_max, outline);
+              });
+
+              const char* label_end = strstr(label, "##");
+              if (label_end != label)
+              {
+                  ImGui::SameLine();
+                  ImGui::TextUnformatted(label, label_end);
+              }
+
+              if (HasSelection)
+              {
+                  gradient::Color4 color = stops[Selected];
+                  float rgba[4] = { color.r, color.g, color.b, color.a };
+                  if (ImGui::ColorEdit4("##stop", rgba))
+                  {
+                      gradient.set(Selected, gradient::Color4{ rgba[0], rgba[1], rgba[2], rgba[3] });
+                      changed = true;
+                  }
+              }
+
+              ImGui::PopID();
+              return changed;
+          }
+
+          // Table kept in sync with the gradient, re-sampled around the edited stops only
+          const gradient::BakedGradient<Key>& GetBaked() const { return Baked; }
+
+          bool GetSelected(Key* key) const
+          {
+              if (HasSelection)
+                  *key = Selected;
+              return HasSelection;
+          }
+
+      private:
+          gradient::BakedGradient<Key> Baked;
+          int Resolution;
+          Key Selected = Key(0);
+          Key RangeFirst = Key(0), RangeLast = Key(1);
+          bool HasSelection = false;
+          bool Dragging = false;
+
+          static float Saturate(float t) { return t < 0.0f ? 0.0f : t > 1.0f ? 1.0f : t; }
+
+          // Nearest stop whose marker is within 'radius' pixels of x
+          bool FindMarker(const G& gradient, float x0, float width, float x, float radius, Key* hit) const
+          {
+              float best = radius;
+              bool found = false;
+              gradient.forEachKey([&](Key key)
+              {
+                  const float distance = fabsf(x0 + width * float((key - RangeFirst) / (RangeLast - RangeFirst)) - x);
+                  if (distance <= best)
+                  {
+                      best = distance;
+                      *hit = key;
+                      found = true;
+                  }
+              });
+              return found;
+          }
+      };
+
+
+      /*---------------------------------------------------------------------------------------------------------
+                                                    IMPLEMENTATION                                             */
+
+      // Compiled in every translation unit by default (as inline functions), only in the IMCANDY_IMPLEMENTATION one
+      // when IMCANDY_SEPARATE_IMPLEMENTATION is defined, see candy_fwd.h
+#if !defined(IMCANDY_SEPARATE_IMPLEMENTATION) || defined(IMCANDY_IMPLEMENTATION)
+
+      IMCANDY_API ImVec4 Rainbow(double &static_ratio, double step)
+      {
+          IMCANDY_METRICS_SCOPE(Rainbow, 1);
+          static const RainbowGradient gradient;
+          return gradient.Step(static_ratio, step * 6); //x6 just to be linear with RainbowP
+      }
+
+      IMCANDY_API ImVec4 RainbowP(RainbowState &state, double step)
+      {
+          IMCANDY_METRICS_SCOPE(Rainbow, 1);
+          // 256 steps per sixth of the wheel, at full saturation and value the ramps of the classic region switch
+          const int normalized = int(state.Ratio * gradient::hue8_steps);
+          const gradient::HSV8 hsv = { ImU16(std::min(std::max(normalized, 0), gradient::hue8_steps - 1)), ImU8(detail::ToByte(state.Saturation)), ImU8(detail::ToByte(state.Value)) };
+          const ImU32 rgb = gradient::hsv8_to_rgba8(hsv);
+
+          state.Ratio += step;
+          if (state.Ratio >= 1.0)
+              state.Ratio = 0.0;
+
+          return ImVec4((rgb & 0xFF) / 255.0, ((rgb >> 8) & 0xFF) / 255.0, ((rgb >> 16) & 0xFF) / 255.0, 1.0);
+      }
+
+      IMCANDY_API ImVec4 RainbowP(double step)
+      {
+          static RainbowState state;
+          return RainbowP(state, step);
+      }
+
+      IMCANDY_API void RainbowPalette(const RainbowState &state, ImU32* colors, int count)
+      {
+          IMCANDY_METRICS_SCOPE(Rainbow, count);
+          const ImU8 s = ImU8(detail::ToByte(state.Saturation));
+          const ImU8 v = ImU8(detail::ToByte(state.Value));
+          const double start = state.Ratio - floor(state.Ratio);
+          gradient::HSV8 hsv[gradient::detail::batch_block];
+          for (int first = 0; first < count; first += int(gradient::detail::batch_block))
+          {
+              const int n = std::min<int>(gradient::detail::batch_block, count - first);
+              for (int i = 0; i < n; i++)
+              {
+                  const double ratio = start + double(first + i) / count;
+                  const int h = int((ratio - (ratio >= 1.0 ? 1.0 : 0.0)) * gradient::hue8_steps);
+                  hsv[i] = gradient::HSV8{ ImU16(std::min(h, gradient::hue8_steps - 1)), s, v };
+              }
+              gradient::hsv8_to_rgba8(hsv, std::size_t(n), colors + first);
+          }
+#if IM_COL32_R_SHIFT != 0
+          // gradient.h packs R in the low byte
+          for (int i = 0; i < count; i++)
+              colors[i] = (colors[i] & 0xFF00FF00) | ((colors[i] & 0xFF) << 16) | ((colors[i] >> 16) & 0xFF);
+#endif
+      }
+
+      IMCANDY_API ImVec4 Gradient2(ImVec4 col1, ImVec4 col2, double &static_ratio, double step, gradient::ColorSpace space)
+      {
+          IMCANDY_METRICS_SCOPE(Gradient2, 1);
+          col1.w = col2.w = 1.0f;
+          const Gradient<3> gradient = {{ col1, col2, col1 }};
+          if (space != gradient::ColorSpace::SRGB)
+              return detail::StepInSpace(gradient, static_ratio, step, space);
+          return gradient.Step(static_ratio, step);
+      }
+
+      IMCANDY_API ImVec4 Gradient3(ImVec4 col1, ImVec4 col2, ImVec4 col3, double &static_ratio, double step, gradient::ColorSpace space)
+      {
+          IMCANDY_METRICS_SCOPE(Gradient3, 1);
+          col1.w = col2.w = col3.w = 1.0f;
+          const Gradient<4> gradient = {{ col1, col2, col3, col1 }};
+          if (space != gradient::ColorSpace::SRGB)
+              return detail::StepInSpace(gradient, static_ratio, step, space);
+          return gradient.Step(static_ratio, step);
+      }
+
+      IMCANDY_API ImU32 Step(const gradient::BakedGradient<>& baked, double &static_ratio, double step, bool interpolate)
+      {
+          ImU32 color = interpolate ? baked.lerp(static_ratio) : baked.nearest(static_ratio);
+#if IM_COL32_R_SHIFT != 0
+          // gradient.h packs R in the low byte
+          color = (color & 0xFF00FF00) | ((color & 0xFF) << 16) | ((color >> 16) & 0xFF);
+#endif
+
+          static_ratio += step;
+          if (static_ratio >= baked.lastKey())
+              static_ratio = baked.firstKey();
+
+          return color;
+      }
+
+      IMCANDY_API ImU32 RainbowU32(double &static_ratio, double step)
+      {
+          static constexpr GradientTable<1024> table = MakeTable<1024>(RainbowGradient());
+          IMCANDY_METRICS_SCOPE(Rainbow, 1);
+          IMCANDY_METRICS_HITS(Rainbow, 1);
+
+          ImU32 color = table.Sample(static_ratio);
+
+          static_ratio += step * 6;
+          if (static_ratio >= 6.0)
+              static_ratio = 0.0;
+
+          return color;
+      }
+
+      IMCANDY_API Animator& GetAnimator()
+      {
+          static Animator animator;
+          return animator;
+      }
+
+      IMCANDY_API void AdjustHSL(const ImU32* src, ImU32* dst, int count, float hue, float saturation, float lightness)
+      {
+#if IM_COL32_R_SHIFT != 0
+          // gradient.h reads R in the low byte: with R and B swapped the hue wheel is mirrored, so rotate the other way
+          hue = -hue;
+#endif
+          gradient::adjust_hsl(src, std::size_t(count), hue, saturation, lightness, dst);
+      }
+
+      IMCANDY_API void AdjustHSL(const ImGuiStyle& base, float hue, float saturation, float lightness, ImGuiStyle* dst)
+      {
+          ImGuiStyle* style = dst ? dst : &ImGui::GetStyle();
+          gradient::adjust_hsl(&base.Colors[0].x, ImGuiCol_COUNT, hue, saturation, lightness, &style->Colors[0].x);
+      }
+
+      IMCANDY_API void ApplyTheme(const Theme& theme, ImGuiStyle* dst)
+      {
+          IMCANDY_METRICS_SCOPE(ApplyTheme, 1);
+          ImGuiStyle* style = dst ? dst : &ImGui::GetStyle();
+
+          if (ImGuiCol_COUNT == detail::DarkTableColorCount)
+          {
+              memcpy(style->Colors, theme.Colors, sizeof(style->Colors));
+          }
+          else
+          {
+              ImGui::StyleColorsDark(style);//Reset to base/dark theme
+              for (int i = 0; i < theme.OverridesCount; i++)
+                  style->Colors[theme.Overrides[i].Index] = theme.Overrides[i].Value;
+          }
+
+          for (int i = 0; i < theme.FloatsCount; i++)
+              style->*(theme.Floats[i].Field) = theme.Floats[i].Value;
+          for (int i = 0; i < theme.Vec2sCount; i++)
+              style->*(theme.Vec2s[i].Field) = theme.Vec2s[i].Value;
+      }
+
+      IMCANDY_API void Theme_Blender(ImGuiStyle* dst)
+      {
+        static IMCANDY_CONSTEXPR14 const Theme theme = MakeTheme_Blender();
+        ApplyTheme(theme, dst);
+      }
+
+      IMCANDY_API void Theme_Cyberpunk(ImGuiStyle* dst)
+      {
+        static IMCANDY_CONSTEXPR14 const Theme theme = MakeTheme_Cyberpunk();
+        ApplyTheme(theme, dst);
+      }
+
+      IMCANDY_API void Theme_Nord(ImGuiStyle* dst)
+      {
+        static IMCANDY_CONSTEXPR14 const Theme theme = MakeTheme_Nord();
+        ApplyTheme(theme, dst);
+      }
+
+      IMCANDY_API ThemeRegistry& GetThemeRegistry()
+      {
+          struct BuiltinRegistry : ThemeRegistry
+          {
+              BuiltinRegistry()
+              {
+                  Register("Dark", MakeTheme_Dark());
+                  Register("Blender", MakeTheme_Blender());
+                  Register("Cyberpunk", MakeTheme_Cyberpunk());
+                  Register("Nord", MakeTheme_Nord());
+              }
+          };
+          static BuiltinRegistry registry;
+          return registry;
+      }
+
+      IMCANDY_API StyleBindings& GetStyleBindings()
+      {
+          static StyleBindings bindings;
+          return bindings;
+      }
+
+      IMCANDY_API void UpdateBindings(ImGuiStyle* dst)
+      {
+          StyleBindings& bindings = GetStyleBindings();
+          bindings.Update();
+          bindings.Apply(dst);
+      }
+
+      IMCANDY_API float GetTimeUntilNextChange()
+      {
+          return std::min(GetAnimator().GetTimeUntilNextChange(), GetStyleBindings().GetTimeUntilNextChange());
+      }
+
+      IMCANDY_API void ShowMetricsWindow(bool* p_open)
+      {
+#if defined(IMCANDY_ENABLE_METRICS)
+          Metrics& metrics = GetMetrics();
+          static int last_frame = -1;
+          if (ImGui::GetFrameCount() != last_frame)
+          {
+              last_frame = ImGui::GetFrameCount();
+              metrics.NextFrame();
+          }
+#endif
+
+          if (!ImGui::Begin("ImCandy Metrics", p_open))
+          {
+              ImGui::End();
+              return;
+          }
+
+#if defined(IMCANDY_ENABLE_METRICS)
+          if (ImGui::Button("Reset"))
+              metrics.Reset();
+
+          if (ImGui::BeginTable("##counters", 6, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders))
+          {
+              ImGui::TableSetupColumn("API");
+              ImGui::TableSetupColumn("Calls");
+              ImGui::TableSetupColumn("Items");
+              ImGui::TableSetupColumn("Allocs");
+              ImGui::TableSetupColumn("Hits");
+              ImGui::TableSetupColumn("ms");
+              ImGui::TableHeadersRow();
+              for (int i = 0; i < MetricsCounter_COUNT; i++)
+              {
+                  const MetricsStats& stats = metrics.GetFrame(MetricsCounter(i));
+                  ImGui::TableNextRow();
+                  ImGui::TableNextColumn(); ImGui::Text("%s", Metrics::GetName(MetricsCounter(i)));
+                  ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)stats.Calls);
+                  ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)stats.Items);
+                  ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)stats.Allocations);
+                  ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)stats.Hits);
+                  ImGui::TableNextColumn(); ImGui::Text("%.3f", stats.Milliseconds);
+              }
+              ImGui::EndTable();
+          }
+
+          // Last Metrics::HistorySize frames, one node per API
+          ImGui::Separator();
+          for (int i = 0; i < MetricsCounter_COUNT; i++)
+          {
+              const MetricsCounter counter = MetricsCounter(i);
+              if (!ImGui::TreeNode(Metrics::GetName(counter)))
+                  continue;
+              char overlay[32];
+              snprintf(overlay, sizeof(overlay), "%.3f ms", metrics.GetFrame(counter).Milliseconds);
+              ImGui::PlotHistogram("Time", metrics.GetHistoryMs(counter), Metrics::HistorySize, metrics.GetHistoryOffset(), overlay, 0.0f, FLT_MAX, ImVec2(0.0f, 60.0f));
+              snprintf(overlay, sizeof(overlay), "%llu", (unsigned long long)metrics.GetFrame(counter).Items);
+              ImGui::PlotHistogram("Items", metrics.GetHistoryItems(counter), Metrics::HistorySize, metrics.GetHistoryOffset(), overlay, 0.0f, FLT_MAX, ImVec2(0.0f, 60.0f));
+              ImGui::TreePop();
+          }
+#else
+          ImGui::TextWrapped("Metrics are disabled, define IMCANDY_ENABLE_METRICS for the whole project to collect them.");
+#endif
+          ImGui::End();
+      }
+#endif
 };
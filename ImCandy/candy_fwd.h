@@ -0,0 +1,86 @@
+/*
+https://github.com/Raais/ImguiCandy
+
+MIT License
+
+Copyright (c) 2021 Raais N.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include "gradient_fwd.h"
+
+// Build modes
+//   default                           header-only, the functions of candy.h are inline
+//   IMCANDY_SEPARATE_IMPLEMENTATION   defined in every translation unit (e.g. by the build system): candy.h only
+//                                     declares its functions and the common gradient.h templates are extern
+//   IMCANDY_IMPLEMENTATION            defined in addition in exactly one .cpp, which compiles all of them once
+#if defined(IMCANDY_SEPARATE_IMPLEMENTATION)
+#define IMCANDY_API
+#if !defined(GRADIENT_SEPARATE_IMPLEMENTATION)
+#define GRADIENT_SEPARATE_IMPLEMENTATION
+#endif
+#if defined(IMCANDY_IMPLEMENTATION) && !defined(GRADIENT_IMPLEMENTATION)
+#define GRADIENT_IMPLEMENTATION
+#endif
+#else
+#define IMCANDY_API inline
+#endif
+
+// IMCANDY_ENABLE_METRICS: per-frame call counts and timings of the ImCandy API, see ShowMetricsWindow()
+#if defined(IMCANDY_ENABLE_METRICS)
+#include "metrics.h"
+#if !defined(GRADIENT_METRICS_SCOPE)
+#define GRADIENT_METRICS_SCOPE(counter, items)  IMCANDY_METRICS_SCOPE(counter, items)
+#define GRADIENT_METRICS_ALLOCS(counter, count) IMCANDY_METRICS_ALLOCS(counter, count)
+#define GRADIENT_METRICS_HITS(counter, count)   IMCANDY_METRICS_HITS(counter, count)
+#endif
+#else
+#define IMCANDY_METRICS_SCOPE(counter, items)
+#define IMCANDY_METRICS_ALLOCS(counter, count)
+#define IMCANDY_METRICS_HITS(counter, count)
+#endif
+
+struct ImVec2;
+struct ImVec4;
+struct ImDrawList;
+struct ImGuiStyle;
+struct ImGuiContext;
+
+// Forward declarations of candy.h, for headers that only pass its types around by reference or pointer
+namespace ImCandy
+{
+      template<int N> struct Gradient;
+      template<int N> struct PerceptualGradient;
+      template<int Resolution> struct GradientTable;
+      struct RainbowGradient;
+      struct RainbowState;
+      struct Theme;
+      class Animator;
+      class ThemeRegistry;
+      class StyleTransition;
+      class Colormap;
+      class ColormapImage;
+      class StyleBindings;
+
+      IMCANDY_API Animator& GetAnimator();
+      IMCANDY_API ThemeRegistry& GetThemeRegistry();
+      IMCANDY_API StyleBindings& GetStyleBindings();
+};
@@ -30,6 +30,7 @@ SOFTWARE.
 #define _USE_MATH_DEFINES
 
 #include <valarray>
+#include <vector>
 #include <ostream>
 #include <algorithm>
 #include <map>
@@ -37,8 +38,34 @@ SOFTWARE.
 #include <functional>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
+#include <limits>
+#include <atomic>
+
+#include "gradient_fwd.h"
+
+#if !defined(GRADIENT_DISABLE_SIMD)
+#if defined(__AVX2__)
+#define GRADIENT_SIMD_AVX2
+#define GRADIENT_SIMD_SSE2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GRADIENT_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define GRADIENT_SIMD_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+// Instrumentation hooks, no-ops unless defined before this header (candy.h does under IMCANDY_ENABLE_METRICS).
+// counter is a token naming what is measured, e.g. GradientEval.
+#if !defined(GRADIENT_METRICS_SCOPE)
+#define GRADIENT_METRICS_SCOPE(counter, items)
+#define GRADIENT_METRICS_ALLOCS(counter, count)
+#define GRADIENT_METRICS_HITS(counter, count)
+#endif
 
-#define GRADIENT_KEY_DEFAULT_PRECISION double
 #define GRADIENT_COLOR_PRECISION_TYPE double
 #define GRADIENT_VALARRAY_FORMAT_OPEN "("
 #define GRADIENT_VALARRAY_FORMAT_CLOSE ")"
@@ -59,6 +86,151 @@ namespace gradient {
     T cosine_interpolation(T x) {
         return T(1) - (cos(x * T(M_PI)) + T(1)) / T(2);
     }
+
+    // Odd polynomial fit of cosine_interpolation around x = 0.5, no call to cos().
+    // Max absolute error against cosine_interpolation on [0, 1] is below 4e-7 (float evaluation included).
+    inline float fast_cosine_interpolation(float x) {
+        const float u = x - 0.5f;
+        const float u2 = u * u;
+        float p = -0.27731809f;
+        p = p * u2 + 1.27094948f;
+        p = p * u2 - 2.58357143f;
+        p = p * u2 + 1.57079101f;
+        return p * u + 0.5f;
+    }
+
+    template<typename T>
+    T smoothstep_interpolation(T x) {
+        return x * x * (T(3) - T(2) * x);
+    }
+
+    // Interpolation policies, for gradients whose curve is fixed at compile time: the call inlines
+    // instead of going through the std::function of the default DynamicInterp.
+    struct LinearInterp {
+        template<typename T> static T apply(T x) { return linear_interpolation(x); }
+    };
+
+    struct CosineInterp {
+        template<typename T> static T apply(T x) { return cosine_interpolation(x); }
+    };
+
+    // Float accuracy, see fast_cosine_interpolation
+    struct FastCosineInterp {
+        template<typename T> static T apply(T x) { return T(fast_cosine_interpolation(float(x))); }
+    };
+
+    struct SmoothstepInterp {
+        template<typename T> static T apply(T x) { return smoothstep_interpolation(x); }
+    };
+
+    // Curve chosen at runtime with setInterpolation()
+    struct DynamicInterp {};
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Color traits  ////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+namespace gradient {
+
+    // Used by the batch API to read colors: channels are read with size() and operator[],
+    // a missing alpha channel reads as max() (opaque).
+    template<typename T>
+    struct color_traits {
+        // Value of a fully saturated channel, Color works in 0-255
+        static double max() { return 255.0; }
+    };
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Change tracking  /////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+namespace gradient {
+
+    // Closed range of key positions, empty when first > last
+    template<typename precision>
+    struct KeyRange {
+        precision first;
+        precision last;
+
+        bool empty() const { return this->last < this->first; }
+
+        static KeyRange none() { return KeyRange{std::numeric_limits<precision>::max(), std::numeric_limits<precision>::lowest()}; }
+        static KeyRange all() { return KeyRange{std::numeric_limits<precision>::lowest(), std::numeric_limits<precision>::max()}; }
+    };
+
+    namespace detail {
+
+        // Every edit of a gradient bumps version() and records the key range whose colors it changed, which
+        // spans from the key point below the edit to the one above it (or to infinity past the end stops).
+        // Consumers keep the version they last synced with and re-sample changedSince(thatVersion) only.
+        // version() of a tracked gradient, 0 for anything else
+        template<typename Gradient>
+        auto version_of(const Gradient& gradient, int) -> decltype(gradient.version()) { return gradient.version(); }
+        template<typename Gradient>
+        std::uint64_t version_of(const Gradient&, long) { return 0; }
+
+        // Unique per gradient object, never reused: tells a cache that an object at the same address is another gradient
+        inline std::uint64_t next_serial() {
+            static std::atomic<std::uint64_t> serial{0};
+            return ++serial;
+        }
+
+        template<typename precision>
+        class ChangeLog {
+        public:
+            ChangeLog() : identity(next_serial()) {}
+            ChangeLog(const ChangeLog& other) : current(other.current), identity(next_serial()) {
+                std::copy(other.changes, other.changes + history, this->changes);
+            }
+            ChangeLog& operator=(const ChangeLog& other) {
+                std::copy(other.changes, other.changes + history, this->changes);
+                this->current = other.current;
+                this->identity = next_serial();
+                return *this;
+            }
+
+            std::uint64_t version() const { return this->current; }
+            std::uint64_t serial() const { return this->identity; }
+
+            // Union of the changes made after 'version', everything when it is too old to be in the log
+            KeyRange<precision> changedSince(std::uint64_t version) const {
+                if (version >= this->current) {
+                    return KeyRange<precision>::none();
+                }
+                if (this->current - version > history) {
+                    return KeyRange<precision>::all();
+                }
+
+                KeyRange<precision> range = KeyRange<precision>::none();
+                for (std::uint64_t v = version + 1; v <= this->current; v++) {
+                    const KeyRange<precision>& change = this->changes[v % history];
+                    range.first = std::min(range.first, change.first);
+                    range.last = std::max(range.last, change.last);
+                }
+                return range;
+            }
+
+        protected:
+            void markChanged(precision first, precision last) {
+                this->current++;
+                this->changes[this->current % history] = KeyRange<precision>{first, last};
+            }
+
+            void markAllChanged() {
+                const KeyRange<precision> all = KeyRange<precision>::all();
+                this->markChanged(all.first, all.last);
+            }
+
+        private:
+            static constexpr std::uint64_t history = 16;
+
+            KeyRange<precision> changes[history] = {};
+            std::uint64_t current = 0;
+            std::uint64_t identity;
+        };
+    }
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -66,11 +238,44 @@ namespace gradient {
 /////////////////////////////////////////////////////////////////////////////
 
 namespace gradient {
-    using default_precision = GRADIENT_KEY_DEFAULT_PRECISION;
     template<typename ratio> using Interpolation = std::function<ratio(ratio x)>;
 
+    namespace detail {
+        template<typename precision> struct FlatStops;
+        template<typename precision> struct StopsView;
+
+        // Heap allocations made by returning one color by value, for the metrics hooks
+        template<typename T> struct value_allocations { static constexpr int value = 0; };
+        template<typename V> struct value_allocations<std::valarray<V>> { static constexpr int value = 1; };
+
+        // How the batch kernels apply the curve, Custom means one call per point
+        enum class Ease { Linear, Cosine, Custom };
+
+        template<typename precision>
+        Ease ease_of(const Interpolation<precision>& interpolation);
+
+        template<typename Interp> struct ease_of_policy { static constexpr Ease value = Ease::Custom; };
+        template<> struct ease_of_policy<LinearInterp> { static constexpr Ease value = Ease::Linear; };
+        template<> struct ease_of_policy<CosineInterp> { static constexpr Ease value = Ease::Cosine; };
+        template<> struct ease_of_policy<FastCosineInterp> { static constexpr Ease value = Ease::Cosine; };
+    }
+
+    template<typename T, typename precision, typename Interp>
+    class GradientBase : public detail::ChangeLog<precision> {
+    public:
+        virtual ~GradientBase() = default;
+
+        precision curve(precision r) const { return Interp::apply(r); }
+        detail::Ease curveKind() const { return detail::ease_of_policy<Interp>::value; }
+
+        T interpolate(const T& lowerBound, const T& upperBound, precision r) const {
+            r = Interp::apply(r);
+            return upperBound * r + lowerBound * (precision(1) - r);
+        }
+    };
+
     template<typename T, typename precision>
-    class GradientBase {
+    class GradientBase<T, precision, DynamicInterp> : public detail::ChangeLog<precision> {
     public:
         explicit GradientBase(const Interpolation<precision>& interpolation)
             : interpolationMethod(interpolation) {}
@@ -80,7 +285,13 @@ namespace gradient {
 
         Interpolation<precision>& interpolation() { return this->interpolationMethod; }
         const Interpolation<precision>& interpolation() const { return this->interpolationMethod; }
-        void setInterpolation(const Interpolation<precision>& interp) { this->interpolationMethod = interp;}
+        void setInterpolation(const Interpolation<precision>& interp) {
+            this->interpolationMethod = interp;
+            this->markAllChanged();
+        }
+
+        precision curve(precision r) const { return this->interpolationMethod(r); }
+        detail::Ease curveKind() const { return detail::ease_of(this->interpolationMethod); }
 
         T interpolate(const T& lowerBound, const T& upperBound, precision r) const {
             assert(interpolationMethod);
@@ -92,18 +303,101 @@ namespace gradient {
         Interpolation<precision> interpolationMethod;
     };
 
-    template<typename T, typename precision = default_precision>
-    class LinearGradient : public GradientBase<T, precision> {
+    template<typename T, typename precision, typename Interp>
+    class LinearGradient : public GradientBase<T, precision, Interp> {
     public:
-        using GradientBase<T, precision>::GradientBase;
+        using GradientBase<T, precision, Interp>::GradientBase;
+        using key_type = precision;
+        using color_type = T;
         ~LinearGradient() override = default;
+
+        // The non-const operator[] cannot tell the write that follows it, so it counts as a change of the
+        // whole gradient (see changedSince()). set() records the segments around keyPoint only.
         T& operator[](precision keyPoint);
         const T& operator[](precision keyPoint) const;
+        void set(precision keyPoint, const T& value);
         T operator()(precision point) const;
 
+        // Removes a key point, false when there is none at keyPoint
+        bool erase(precision keyPoint);
+        // Moves a key point with its color, false when 'from' does not exist or 'to' is taken
+        bool move(precision from, precision to);
+
+        // Batch evaluation, see below. Float output is 4 floats (RGBA) per point in the color's own units,
+        // packed output is one RGBA8 value per point (R in the low byte, like IM_COL32).
+        // The scratch overloads reuse the stops flattened by earlier calls, see BatchScratch.
+        void evaluate(const precision* points, std::size_t count, float* rgba) const;
+        void evaluate(const precision* points, std::size_t count, std::uint32_t* packed) const;
+        void evaluate(const precision* points, std::size_t count, float* rgba, BatchScratch<precision>& scratch) const;
+        void evaluate(const precision* points, std::size_t count, std::uint32_t* packed, BatchScratch<precision>& scratch) const;
+
+        std::size_t size() const { return this->keyPoints.size(); }
+        precision firstKey() const { return this->keyPoints.begin()->first; }
+        precision lastKey() const { return this->keyPoints.rbegin()->first; }
+
+        // Calls visit(key) for every key point in ascending order
+        template<typename Visitor>
+        void forEachKey(Visitor visit) const {
+            for (const auto& keyPoint : this->keyPoints) {
+                visit(keyPoint.first);
+            }
+        }
+
     private:
+        void markAround(precision keyPoint);
+
         std::map<precision, T> keyPoints;
     };
+
+    // Same interface as LinearGradient, but the key points live in two contiguous sorted arrays
+    // instead of a std::map. When the keys are evenly spaced the segment is found with a multiply,
+    // otherwise with a branchless binary search.
+    // Unlike LinearGradient, inserting a new key point invalidates references returned by operator[].
+    template<typename T, typename precision, typename Interp>
+    class FlatLinearGradient : public GradientBase<T, precision, Interp> {
+    public:
+        using GradientBase<T, precision, Interp>::GradientBase;
+        using key_type = precision;
+        using color_type = T;
+        ~FlatLinearGradient() override = default;
+        T& operator[](precision keyPoint);
+        const T& operator[](precision keyPoint) const;
+        void set(precision keyPoint, const T& value);
+        T operator()(precision point) const;
+
+        bool erase(precision keyPoint);
+        bool move(precision from, precision to);
+
+        // Color4 stops are read in place, other colors are flattened like LinearGradient
+        void evaluate(const precision* points, std::size_t count, float* rgba) const;
+        void evaluate(const precision* points, std::size_t count, std::uint32_t* packed) const;
+        void evaluate(const precision* points, std::size_t count, float* rgba, BatchScratch<precision>& scratch) const;
+        void evaluate(const precision* points, std::size_t count, std::uint32_t* packed, BatchScratch<precision>& scratch) const;
+
+        std::size_t size() const { return this->keys.size(); }
+        bool uniform() const { return this->evenlySpaced; }
+        precision firstKey() const { return this->keys.front(); }
+        precision lastKey() const { return this->keys.back(); }
+
+        template<typename Visitor>
+        void forEachKey(Visitor visit) const {
+            for (precision key : this->keys) {
+                visit(key);
+            }
+        }
+
+    private:
+        // Stops in the kernels' layout without copying them, false when T is not 4 floats
+        bool directStops(detail::StopsView<precision>& view) const;
+        std::size_t segment(precision point) const;
+        void updateSpacing();
+        void markAround(precision keyPoint);
+
+        std::vector<precision> keys;
+        std::vector<T> values;
+        bool evenlySpaced = false;
+        precision inverseSpacing = precision(0);
+    };
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -138,18 +432,65 @@ namespace gradient {
 
 namespace gradient {
 
-    template<typename T, typename precision>
-    T &LinearGradient<T, precision>::operator[](precision keyPoint) {
+    template<typename T, typename precision, typename Interp>
+    T &LinearGradient<T, precision, Interp>::operator[](precision keyPoint) {
+        this->markAllChanged();
         return this->keyPoints[keyPoint];
     }
 
-    template<typename T, typename precision>
-    const T& LinearGradient<T, precision>::operator[](precision keyPoint) const {
+    template<typename T, typename precision, typename Interp>
+    void LinearGradient<T, precision, Interp>::set(precision keyPoint, const T& value) {
+        this->markAround(keyPoint);
+        this->keyPoints[keyPoint] = value;
+    }
+
+    template<typename T, typename precision, typename Interp>
+    bool LinearGradient<T, precision, Interp>::erase(precision keyPoint) {
+        const auto it = this->keyPoints.find(keyPoint);
+        if (it == this->keyPoints.end()) {
+            return false;
+        }
+        this->markAround(keyPoint);
+        this->keyPoints.erase(it);
+        return true;
+    }
+
+    template<typename T, typename precision, typename Interp>
+    bool LinearGradient<T, precision, Interp>::move(precision from, precision to) {
+        const auto it = this->keyPoints.find(from);
+        if (it == this->keyPoints.end() || (to != from && this->keyPoints.count(to))) {
+            return false;
+        }
+        if (to == from) {
+            return true;
+        }
+        T value = it->second;
+        this->markAround(from);
+        this->keyPoints.erase(it);
+        this->markAround(to);
+        this->keyPoints.emplace(to, value);
+        return true;
+    }
+
+    // Records [key point below keyPoint, key point above it] as changed, ignoring a key point at keyPoint itself
+    template<typename T, typename precision, typename Interp>
+    void LinearGradient<T, precision, Interp>::markAround(precision keyPoint) {
+        const auto below = this->keyPoints.lower_bound(keyPoint);
+        const auto above = this->keyPoints.upper_bound(keyPoint);
+        const KeyRange<precision> all = KeyRange<precision>::all();
+        this->markChanged(below == this->keyPoints.begin() ? all.first : std::prev(below)->first,
+                          above == this->keyPoints.end() ? all.last : above->first);
+    }
+
+    template<typename T, typename precision, typename Interp>
+    const T& LinearGradient<T, precision, Interp>::operator[](precision keyPoint) const {
         return this->keyPoints.at(keyPoint);
     }
 
-    template<typename T, typename precision>
-    T LinearGradient<T, precision>::operator()(precision point) const {
+    template<typename T, typename precision, typename Interp>
+    T LinearGradient<T, precision, Interp>::operator()(precision point) const {
+        GRADIENT_METRICS_SCOPE(GradientEval, 1);
+        GRADIENT_METRICS_ALLOCS(GradientEval, detail::value_allocations<T>::value);
 
         assert(!this->keyPoints.empty());
         T returnValue;
@@ -180,16 +521,1684 @@ namespace gradient {
 }
 
 /////////////////////////////////////////////////////////////////////////////
-// User-Defined Types  //////////////////////////////////////////////////////
+// FlatLinearGradient implementation  ///////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////
 
 namespace gradient {
 
-    using Color = std::valarray<GRADIENT_COLOR_PRECISION_TYPE>;
-    using LinearColorGradient = LinearGradient<Color>;
+    template<typename T, typename precision, typename Interp>
+    T &FlatLinearGradient<T, precision, Interp>::operator[](precision keyPoint) {
+        const auto it = std::lower_bound(this->keys.begin(), this->keys.end(), keyPoint);
+        const std::size_t index = std::size_t(it - this->keys.begin());
+
+        this->markAllChanged();
+        if (it == this->keys.end() || *it != keyPoint) {
+            this->keys.insert(it, keyPoint);
+            this->values.insert(this->values.begin() + index, T());
+            this->updateSpacing();
+        }
+
+        return this->values[index];
+    }
+
+    template<typename T, typename precision, typename Interp>
+    void FlatLinearGradient<T, precision, Interp>::set(precision keyPoint, const T& value) {
+        const auto it = std::lower_bound(this->keys.begin(), this->keys.end(), keyPoint);
+        const std::size_t index = std::size_t(it - this->keys.begin());
+
+        this->markAround(keyPoint);
+        if (it == this->keys.end() || *it != keyPoint) {
+            this->keys.insert(it, keyPoint);
+            this->values.insert(this->values.begin() + index, value);
+            this->updateSpacing();
+        } else {
+            this->values[index] = value;
+        }
+    }
+
+    template<typename T, typename precision, typename Interp>
+    const T& FlatLinearGradient<T, precision, Interp>::operator[](precision keyPoint) const {
+        const auto it = std::lower_bound(this->keys.begin(), this->keys.end(), keyPoint);
+
+        if (it == this->keys.end() || *it != keyPoint) {
+            throw std::out_of_range("FlatLinearGradient: no such key point");
+        }
+
+        return this->values[std::size_t(it - this->keys.begin())];
+    }
+
+    template<typename T, typename precision, typename Interp>
+    T FlatLinearGradient<T, precision, Interp>::operator()(precision point) const {
+        GRADIENT_METRICS_SCOPE(GradientEval, 1);
+        GRADIENT_METRICS_ALLOCS(GradientEval, detail::value_allocations<T>::value);
+
+        assert(!this->keys.empty());
+        const std::size_t last = this->keys.size() - 1;
+
+        // Same clamping as LinearGradient: the first key for anything below it, the last key for anything at or above it
+        if (point < this->keys[0]) {
+            return this->values[0];
+        }
+        if (!(point < this->keys[last])) {
+            return this->values[last];
+        }
+
+        const std::size_t i = this->segment(point);
+        const precision min_point = this->keys[i];
+        const precision max_point = this->keys[i + 1];
+        const precision ratio = (point - min_point) / (max_point - min_point);
+        return this->interpolate(this->values[i], this->values[i + 1], ratio);
+    }
+
+    // Index of the segment [keys[i], keys[i + 1]) containing point, with keys[0] <= point < keys.back()
+    template<typename T, typename precision, typename Interp>
+    std::size_t FlatLinearGradient<T, precision, Interp>::segment(precision point) const {
+        const std::size_t lastSegment = this->keys.size() - 2;
+
+        if (this->evenlySpaced) {
+            const std::size_t i = std::size_t((point - this->keys[0]) * this->inverseSpacing);
+            return std::min(i, lastSegment);
+        }
+
+        const precision* base = this->keys.data();
+        std::size_t count = this->keys.size();
+        while (count > 1) {
+            const std::size_t half = count / 2;
+            base = (base[half] <= point) ? base + half : base;
+            count -= half;
+        }
+
+        return std::min(std::size_t(base - this->keys.data()), lastSegment);
+    }
+
+    template<typename T, typename precision, typename Interp>
+    bool FlatLinearGradient<T, precision, Interp>::erase(precision keyPoint) {
+        const auto it = std::lower_bound(this->keys.begin(), this->keys.end(), keyPoint);
+        if (it == this->keys.end() || *it != keyPoint) {
+            return false;
+        }
+        this->markAround(keyPoint);
+        this->values.erase(this->values.begin() + (it - this->keys.begin()));
+        this->keys.erase(it);
+        this->updateSpacing();
+        return true;
+    }
+
+    template<typename T, typename precision, typename Interp>
+    bool FlatLinearGradient<T, precision, Interp>::move(precision from, precision to) {
+        const auto it = std::lower_bound(this->keys.begin(), this->keys.end(), from);
+        if (it == this->keys.end() || *it != from || (to != from && std::binary_search(this->keys.begin(), this->keys.end(), to))) {
+            return false;
+        }
+        if (to == from) {
+            return true;
+        }
+        T value = this->values[std::size_t(it - this->keys.begin())];
+        this->erase(from);
+        this->set(to, value);
+        return true;
+    }
+
+    template<typename T, typename precision, typename Interp>
+    void FlatLinearGradient<T, precision, Interp>::markAround(precision keyPoint) {
+        const auto below = std::lower_bound(this->keys.begin(), this->keys.end(), keyPoint);
+        const auto above = std::upper_bound(below, this->keys.end(), keyPoint);
+        const KeyRange<precision> all = KeyRange<precision>::all();
+        this->markChanged(below == this->keys.begin() ? all.first : *(below - 1),
+                          above == this->keys.end() ? all.last : *above);
+    }
+
+    template<typename T, typename precision, typename Interp>
+    void FlatLinearGradient<T, precision, Interp>::updateSpacing() {
+        const std::size_t count = this->keys.size();
+        this->evenlySpaced = false;
+
+        if (count < 2) {
+            return;
+        }
+
+        const precision spacing = (this->keys[count - 1] - this->keys[0]) / precision(count - 1);
+        const precision tolerance = spacing * precision(1e-6);
+        for (std::size_t i = 1; i < count - 1; i++) {
+            const precision expected = this->keys[0] + spacing * precision(i);
+            if (std::abs(this->keys[i] - expected) > tolerance) {
+                return;
+            }
+        }
+
+        this->evenlySpaced = true;
+        this->inverseSpacing = precision(1) / spacing;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Batch evaluation  ////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+// Points are evaluated in blocks: segment lookup and the interpolation curve are scalar, then the curve
+// (linear or cosine), the RGBA lerp and the 8-bit packing run on AVX2/SSE2/NEON. Every vector path does
+// the same float operations in the same order as the scalar fallback, so results are identical
+// (as long as the compiler is not allowed to contract the scalar code into FMAs).
+// Other curves (custom setInterpolation() functions, SmoothstepInterp) are called once per point.
+
+namespace gradient {
+
+    namespace detail {
+
+        template<typename precision>
+        Ease ease_of(const Interpolation<precision>& interpolation) {
+            using function = precision (*)(precision);
+            const function* target = interpolation.template target<function>();
+            if (target && *target == &linear_interpolation<precision>) {
+                return Ease::Linear;
+            }
+            if (target && *target == &cosine_interpolation<precision>) {
+                return Ease::Cosine;
+            }
+            return Ease::Custom;
+        }
+
+        // Key points as the kernels read them: sorted keys and 4 floats (RGBA) per key
+        template<typename precision>
+        struct StopsView {
+            const precision* keys;
+            const float* rgba;
+            std::size_t size;
+        };
+
+        // True for colors laid out as 4 floats (Color4), which the kernels read in place
+        template<typename T> struct rgba_layout { static constexpr bool value = false; };
+
+        constexpr std::size_t inline_stops = 16;
+
+        // Key points flattened to float RGBA. Up to inline_stops of them live in the object itself,
+        // so flattening a small gradient into a local FlatStops does not allocate.
+        template<typename precision>
+        struct FlatStops {
+            template<typename Gradient>
+            void assign(const Gradient& gradient) {
+                this->clear();
+                if (gradient.size() > inline_stops) {
+                    this->reserve(gradient.size());
+                }
+                gradient.forEachKey([&](precision key) { this->push(key, gradient[key]); });
+            }
+
+            template<typename T>
+            void push(precision key, const T& color) {
+                float rgba[4];
+                const std::size_t channels = std::min<std::size_t>(color.size(), 4);
+                for (std::size_t c = 0; c < 4; c++) {
+                    rgba[c] = c < channels ? float(color[c]) : c == 3 ? float(color_traits<T>::max()) : 0.0f;
+                }
+
+                if (this->count < inline_stops && this->heapKeys.empty()) {
+                    this->localKeys[this->count] = key;
+                    std::copy(rgba, rgba + 4, this->localRgba + 4 * this->count);
+                } else {
+                    if (this->heapKeys.empty()) {
+                        this->reserve(2 * this->count);
+                        this->heapKeys.assign(this->localKeys, this->localKeys + this->count);
+                        this->heapRgba.assign(this->localRgba, this->localRgba + 4 * this->count);
+                    }
+                    this->heapKeys.push_back(key);
+                    this->heapRgba.insert(this->heapRgba.end(), rgba, rgba + 4);
+                }
+                this->count++;
+            }
+
+            // Keeps the heap capacity for the next assign()
+            void clear() {
+                this->count = 0;
+                this->heapKeys.clear();
+                this->heapRgba.clear();
+            }
+
+            StopsView<precision> view() const {
+                return this->heapKeys.empty() ? StopsView<precision>{this->localKeys, this->localRgba, this->count}
+                                              : StopsView<precision>{this->heapKeys.data(), this->heapRgba.data(), this->count};
+            }
+
+            std::size_t size() const { return this->count; }
+
+        private:
+            void reserve(std::size_t stops) {
+                if (stops > this->heapKeys.capacity()) {
+                    GRADIENT_METRICS_ALLOCS(GradientBatch, 2);
+                    this->heapKeys.reserve(stops);
+                    this->heapRgba.reserve(4 * stops);
+                }
+            }
+
+            precision localKeys[inline_stops];
+            float localRgba[4 * inline_stops];
+            std::vector<precision> heapKeys;
+            std::vector<float> heapRgba;
+            std::size_t count = 0;
+        };
+
+        inline void ease_cosine(float* t, std::size_t count) {
+            std::size_t i = 0;
+#if defined(GRADIENT_SIMD_AVX2)
+            {
+                const __m256 half = _mm256_set1_ps(0.5f);
+                for (; i + 8 <= count; i += 8) {
+                    const __m256 u = _mm256_sub_ps(_mm256_loadu_ps(t + i), half);
+                    const __m256 u2 = _mm256_mul_ps(u, u);
+                    __m256 p = _mm256_set1_ps(-0.27731809f);
+                    p = _mm256_add_ps(_mm256_mul_ps(p, u2), _mm256_set1_ps(1.27094948f));
+                    p = _mm256_sub_ps(_mm256_mul_ps(p, u2), _mm256_set1_ps(2.58357143f));
+                    p = _mm256_add_ps(_mm256_mul_ps(p, u2), _mm256_set1_ps(1.57079101f));
+                    _mm256_storeu_ps(t + i, _mm256_add_ps(_mm256_mul_ps(p, u), half));
+                }
+            }
+#endif
+#if defined(GRADIENT_SIMD_SSE2)
+            {
+                const __m128 half = _mm_set1_ps(0.5f);
+                for (; i + 4 <= count; i += 4) {
+                    const __m128 u = _mm_sub_ps(_mm_loadu_ps(t + i), half);
+                    const __m128 u2 = _mm_mul_ps(u, u);
+                    __m128 p = _mm_set1_ps(-0.27731809f);
+                    p = _mm_add_ps(_mm_mul_ps(p, u2), _mm_set1_ps(1.27094948f));
+                    p = _mm_sub_ps(_mm_mul_ps(p, u2), _mm_set1_ps(2.58357143f));
+                    p = _mm_add_ps(_mm_mul_ps(p, u2), _mm_set1_ps(1.57079101f));
+                    _mm_storeu_ps(t + i, _mm_add_ps(_mm_mul_ps(p, u), half));
+                }
+            }
+#elif defined(GRADIENT_SIMD_NEON)
+            {
+                const float32x4_t half = vdupq_n_f32(0.5f);
+                for (; i + 4 <= count; i += 4) {
+                    const float32x4_t u = vsubq_f32(vld1q_f32(t + i), half);
+                    const float32x4_t u2 = vmulq_f32(u, u);
+                    float32x4_t p = vdupq_n_f32(-0.27731809f);
+                    p = vaddq_f32(vmulq_f32(p, u2), vdupq_n_f32(1.27094948f));
+                    p = vsubq_f32(vmulq_f32(p, u2), vdupq_n_f32(2.58357143f));
+                    p = vaddq_f32(vmulq_f32(p, u2), vdupq_n_f32(1.57079101f));
+                    vst1q_f32(t + i, vaddq_f32(vmulq_f32(p, u), half));
+                }
+            }
+#endif
+            for (; i < count; i++) {
+                t[i] = fast_cosine_interpolation(t[i]);
+            }
+        }
+
+        // out[i] = rgba[hi[i]] * t[i] + rgba[lo[i]] * (1 - t[i]), 4 channels per point
+        inline void lerp_rgba(const float* rgba, const std::uint32_t* lo, const std::uint32_t* hi, const float* t,
+                              std::size_t count, float* out) {
+            std::size_t i = 0;
+#if defined(GRADIENT_SIMD_AVX2)
+            {
+                const __m256 one = _mm256_set1_ps(1.0f);
+                for (; i + 2 <= count; i += 2) {
+                    const __m256 min = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(rgba + 4 * lo[i])), _mm_loadu_ps(rgba + 4 * lo[i + 1]), 1);
+                    const __m256 max = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(rgba + 4 * hi[i])), _mm_loadu_ps(rgba + 4 * hi[i + 1]), 1);
+                    const __m256 r = _mm256_set_ps(t[i + 1], t[i + 1], t[i + 1], t[i + 1], t[i], t[i], t[i], t[i]);
+                    _mm256_storeu_ps(out + 4 * i, _mm256_add_ps(_mm256_mul_ps(max, r), _mm256_mul_ps(min, _mm256_sub_ps(one, r))));
+                }
+            }
+#endif
+#if defined(GRADIENT_SIMD_SSE2)
+            {
+                const __m128 one = _mm_set1_ps(1.0f);
+                for (; i < count; i++) {
+                    const __m128 r = _mm_set1_ps(t[i]);
+                    const __m128 min = _mm_loadu_ps(rgba + 4 * lo[i]);
+                    const __m128 max = _mm_loadu_ps(rgba + 4 * hi[i]);
+                    _mm_storeu_ps(out + 4 * i, _mm_add_ps(_mm_mul_ps(max, r), _mm_mul_ps(min, _mm_sub_ps(one, r))));
+                }
+            }
+#elif defined(GRADIENT_SIMD_NEON)
+            {
+                const float32x4_t one = vdupq_n_f32(1.0f);
+                for (; i < count; i++) {
+                    const float32x4_t r = vdupq_n_f32(t[i]);
+                    const float32x4_t min = vld1q_f32(rgba + 4 * lo[i]);
+                    const float32x4_t max = vld1q_f32(rgba + 4 * hi[i]);
+                    vst1q_f32(out + 4 * i, vaddq_f32(vmulq_f32(max, r), vmulq_f32(min, vsubq_f32(one, r))));
+                }
+            }
+#endif
+            for (; i < count; i++) {
+                const float r = t[i];
+                const float* min = rgba + 4 * lo[i];
+                const float* max = rgba + 4 * hi[i];
+                for (std::size_t c = 0; c < 4; c++) {
+                    out[4 * i + c] = max[c] * r + min[c] * (1.0f - r);
+                }
+            }
+        }
+
+        // out = a * (1 - t) + b * t over count RGBA colors with one t, e.g. two whole color tables
+        inline void lerp_colors(const float* a, const float* b, float t, std::size_t count, float* out) {
+            std::size_t i = 0;
+#if defined(GRADIENT_SIMD_AVX2)
+            {
+                const __m256 r = _mm256_set1_ps(t);
+                const __m256 s = _mm256_set1_ps(1.0f - t);
+                for (; i + 2 <= count; i += 2) {
+                    _mm256_storeu_ps(out + 4 * i, _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(b + 4 * i), r), _mm256_mul_ps(_mm256_loadu_ps(a + 4 * i), s)));
+                }
+            }
+#endif
+#if defined(GRADIENT_SIMD_SSE2)
+            {
+                const __m128 r = _mm_set1_ps(t);
+                const __m128 s = _mm_set1_ps(1.0f - t);
+                for (; i < count; i++) {
+                    _mm_storeu_ps(out + 4 * i, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(b + 4 * i), r), _mm_mul_ps(_mm_loadu_ps(a + 4 * i), s)));
+                }
+            }
+#elif defined(GRADIENT_SIMD_NEON)
+            {
+                const float32x4_t r = vdupq_n_f32(t);
+                const float32x4_t s = vdupq_n_f32(1.0f - t);
+                for (; i < count; i++) {
+                    vst1q_f32(out + 4 * i, vaddq_f32(vmulq_f32(vld1q_f32(b + 4 * i), r), vmulq_f32(vld1q_f32(a + 4 * i), s)));
+                }
+            }
+#endif
+            for (; i < count; i++) {
+                for (std::size_t c = 0; c < 4; c++) {
+                    out[4 * i + c] = b[4 * i + c] * t + a[4 * i + c] * (1.0f - t);
+                }
+            }
+        }
+
+        // Scales each channel by 'scale', rounds and saturates to 0-255, one RGBA8 value per 4 floats
+        inline void pack_rgba8(const float* in, std::size_t count, float scale, std::uint32_t* out) {
+            std::size_t i = 0;
+#if defined(GRADIENT_SIMD_SSE2)
+            {
+                const __m128 s = _mm_set1_ps(scale);
+                const __m128 half = _mm_set1_ps(0.5f);
+                const __m128 zero = _mm_setzero_ps();
+                const __m128 top = _mm_set1_ps(255.0f);
+                for (; i + 4 <= count; i += 4) {
+                    __m128i c[4];
+                    for (int k = 0; k < 4; k++) {
+                        const __m128 v = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(in + 4 * (i + k)), s), half);
+                        c[k] = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(v, zero), top));
+                    }
+                    const __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(c[0], c[1]), _mm_packs_epi32(c[2], c[3]));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), bytes);
+                }
+            }
+#elif defined(GRADIENT_SIMD_NEON)
+            {
+                const float32x4_t s = vdupq_n_f32(scale);
+                const float32x4_t half = vdupq_n_f32(0.5f);
+                const float32x4_t zero = vdupq_n_f32(0.0f);
+                const float32x4_t top = vdupq_n_f32(255.0f);
+                for (; i + 4 <= count; i += 4) {
+                    uint16x4_t c[4];
+                    for (int k = 0; k < 4; k++) {
+                        const float32x4_t v = vaddq_f32(vmulq_f32(vld1q_f32(in + 4 * (i + k)), s), half);
+                        c[k] = vmovn_u32(vcvtq_u32_f32(vminq_f32(vmaxq_f32(v, zero), top)));
+                    }
+                    const uint8x16_t bytes = vcombine_u8(vmovn_u16(vcombine_u16(c[0], c[1])), vmovn_u16(vcombine_u16(c[2], c[3])));
+                    vst1q_u32(out + i, vreinterpretq_u32_u8(bytes));
+                }
+            }
+#endif
+            for (; i < count; i++) {
+                std::uint32_t color = 0;
+                for (std::size_t c = 0; c < 4; c++) {
+                    const float v = std::min(std::max(in[4 * i + c] * scale + 0.5f, 0.0f), 255.0f);
+                    color |= std::uint32_t(v) << (8 * c);
+                }
+                out[i] = color;
+            }
+        }
+
+        // Same segment and clamping rules as LinearGradient::operator()
+        template<typename precision, typename Curve>
+        void locate(const StopsView<precision>& stops, Ease ease, const Curve& curve,
+                    const precision* points, std::size_t count, std::uint32_t* lo, std::uint32_t* hi, float* t) {
+            const precision* keys = stops.keys;
+            const std::size_t last = stops.size - 1;
+
+            for (std::size_t i = 0; i < count; i++) {
+                const precision point = points[i];
+
+                if (point < keys[0] || !(point < keys[last])) {
+                    lo[i] = hi[i] = std::uint32_t(point < keys[0] ? 0 : last);
+                    t[i] = 0.0f;
+                    continue;
+                }
+
+                const precision* base = keys;
+                std::size_t n = last + 1;
+                while (n > 1) {
+                    const std::size_t half = n / 2;
+                    base = (base[half] <= point) ? base + half : base;
+                    n -= half;
+                }
+                const std::size_t segment = std::min(std::size_t(base - keys), last - 1);
+
+                const precision ratio = (point - keys[segment]) / (keys[segment + 1] - keys[segment]);
+                lo[i] = std::uint32_t(segment);
+                hi[i] = std::uint32_t(segment + 1);
+                t[i] = float(ease == Ease::Custom ? curve.curve(ratio) : ratio);
+            }
+        }
+
+        constexpr std::size_t batch_block = 64;
+
+        // Curve is the gradient itself, for curve() and curveKind()
+        template<typename precision, typename Curve>
+        void evaluate_batch(const StopsView<precision>& stops, const Curve& curve,
+                            const precision* points, std::size_t count, float* rgba) {
+            assert(stops.size > 0);
+            const Ease ease = curve.curveKind();
+            std::uint32_t lo[batch_block], hi[batch_block];
+            float t[batch_block];
+
+            for (std::size_t first = 0; first < count; first += batch_block) {
+                const std::size_t n = std::min(batch_block, count - first);
+                locate(stops, ease, curve, points + first, n, lo, hi, t);
+                if (ease == Ease::Cosine) {
+                    ease_cosine(t, n);
+                }
+                lerp_rgba(stops.rgba, lo, hi, t, n, rgba + 4 * first);
+            }
+        }
+
+        template<typename precision, typename Curve>
+        void evaluate_batch(const StopsView<precision>& stops, const Curve& curve,
+                            const precision* points, std::size_t count, float scale, std::uint32_t* packed) {
+            float rgba[4 * batch_block];
+
+            for (std::size_t first = 0; first < count; first += batch_block) {
+                const std::size_t n = std::min(batch_block, count - first);
+                evaluate_batch(stops, curve, points + first, n, rgba);
+                pack_rgba8(rgba, n, scale, packed + first);
+            }
+        }
+    }
+
+    // Caller-owned copy of a gradient's stops for the evaluate() overloads that take one. The stops are flattened
+    // again only when the gradient changed (see version()) or is another object, so repeated batches from a
+    // LinearGradient or a large gradient skip the flattening; up to 16 stops it never allocates either.
+    // One per thread. A color written through a reference from operator[] after an evaluate() with this scratch
+    // is not seen by the next one: write it right away, or with set().
+    template<typename precision>
+    class BatchScratch {
+    public:
+        template<typename Gradient>
+        detail::StopsView<precision> stopsOf(const Gradient& gradient) {
+            if (gradient.serial() != this->serial || gradient.version() != this->version) {
+                this->stops.assign(gradient);
+                this->serial = gradient.serial();
+                this->version = gradient.version();
+            }
+            return this->stops.view();
+        }
+
+    private:
+        detail::FlatStops<precision> stops;
+        std::uint64_t serial = 0;
+        std::uint64_t version = 0;
+    };
+
+    template<typename T, typename precision, typename Interp>
+    void LinearGradient<T, precision, Interp>::evaluate(const precision* points, std::size_t count, float* rgba) const {
+        GRADIENT_METRICS_SCOPE(GradientBatch, count);
+        detail::FlatStops<precision> stops;
+        stops.assign(*this);
+        detail::evaluate_batch(stops.view(), *this, points, count, rgba);
+    }
+
+    template<typename T, typename precision, typename Interp>
+    void LinearGradient<T, precision, Interp>::evaluate(const precision* points, std::size_t count, std::uint32_t* packed) const {
+        GRADIENT_METRICS_SCOPE(GradientBatch, count);
+        const float scale = float(255.0 / color_traits<T>::max());
+        detail::FlatStops<precision> stops;
+        stops.assign(*this);
+        detail::evaluate_batch(stops.view(), *this, points, count, scale, packed);
+    }
+
+    template<typename T, typename precision, typename Interp>
+    void LinearGradient<T, precision, Interp>::evaluate(const precision* points, std::size_t count, float* rgba, BatchScratch<precision>& scratch) const {
+        GRADIENT_METRICS_SCOPE(GradientBatch, count);
+        detail::evaluate_batch(scratch.stopsOf(*this), *this, points, count, rgba);
+    }
+
+    template<typename T, typename precision, typename Interp>
+    void LinearGradient<T, precision, Interp>::evaluate(const precision* points, std::size_t count, std::uint32_t* packed, BatchScratch<precision>& scratch) const {
+        GRADIENT_METRICS_SCOPE(GradientBatch, count);
+        const float scale = float(255.0 / color_traits<T>::max());
+        detail::evaluate_batch(scratch.stopsOf(*this), *this, points, count, scale, packed);
+    }
+
+    namespace detail {
+        template<typename T, typename precision, bool = rgba_layout<T>::value>
+        struct direct_stops {
+            static bool get(const std::vector<precision>&, const std::vector<T>&, StopsView<precision>&) { return false; }
+        };
+
+        template<typename T, typename precision>
+        struct direct_stops<T, precision, true> {
+            static bool get(const std::vector<precision>& keys, const std::vector<T>& values, StopsView<precision>& view) {
+                view = StopsView<precision>{keys.data(), reinterpret_cast<const float*>(values.data()), keys.size()};
+                return true;
+            }
+        };
+    }
+
+    template<typename T, typename precision, typename Interp>
+    bool FlatLinearGradient<T, precision, Interp>::directStops(detail::StopsView<precision>& view) const {
+        return detail::direct_stops<T, precision>::get(this->keys, this->values, view);
+    }
+
+    template<typename T, typename precision, typename Interp>
+    void FlatLinearGradient<T, precision, Interp>::evaluate(const precision* points, std::size_t count, float* rgba) const {
+        GRADIENT_METRICS_SCOPE(GradientBatch, count);
+        detail::StopsView<precision> view;
+        if (this->directStops(view)) {
+            detail::evaluate_batch(view, *this, points, count, rgba);
+            return;
+        }
+        detail::FlatStops<precision> stops;
+        stops.assign(*this);
+        detail::evaluate_batch(stops.view(), *this, points, count, rgba);
+    }
+
+    template<typename T, typename precision, typename Interp>
+    void FlatLinearGradient<T, precision, Interp>::evaluate(const precision* points, std::size_t count, std::uint32_t* packed) const {
+        GRADIENT_METRICS_SCOPE(GradientBatch, count);
+        const float scale = float(255.0 / color_traits<T>::max());
+        detail::StopsView<precision> view;
+        if (this->directStops(view)) {
+            detail::evaluate_batch(view, *this, points, count, scale, packed);
+            return;
+        }
+        detail::FlatStops<precision> stops;
+        stops.assign(*this);
+        detail::evaluate_batch(stops.view(), *this, points, count, scale, packed);
+    }
+
+    template<typename T, typename precision, typename Interp>
+    void FlatLinearGradient<T, precision, Interp>::evaluate(const precision* points, std::size_t count, float* rgba, BatchScratch<precision>& scratch) const {
+        GRADIENT_METRICS_SCOPE(GradientBatch, count);
+        detail::StopsView<precision> view;
+        detail::evaluate_batch(this->directStops(view) ? view : scratch.stopsOf(*this), *this, points, count, rgba);
+    }
+
+    template<typename T, typename precision, typename Interp>
+    void FlatLinearGradient<T, precision, Interp>::evaluate(const precision* points, std::size_t count, std::uint32_t* packed, BatchScratch<precision>& scratch) const {
+        GRADIENT_METRICS_SCOPE(GradientBatch, count);
+        const float scale = float(255.0 / color_traits<T>::max());
+        detail::StopsView<precision> view;
+        detail::evaluate_batch(this->directStops(view) ? view : scratch.stopsOf(*this), *this, points, count, scale, packed);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// BakedGradient  ///////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+namespace gradient {
+
+    // Any gradient sampled once into a table of packed RGBA8 colors (same layout as the packed batch output).
+    // The source only needs evaluate(points, count, std::uint32_t*), so custom interpolations are baked in as well.
+    // Lookups are then a single indexed load (nearest) or a blend of the two closest entries (lerp).
+    template<typename precision>
+    class BakedGradient {
+    public:
+        BakedGradient() = default;
+
+        // Bakes over the key range of the gradient, resolution is usually 256, 1024 or 4096
+        template<typename Gradient>
+        explicit BakedGradient(const Gradient& gradient, std::size_t resolution = 256) {
+            this->bake(gradient, resolution);
+        }
+
+        template<typename Gradient>
+        void bake(const Gradient& gradient, std::size_t resolution = 256) {
+            this->bake(gradient, gradient.firstKey(), gradient.lastKey(), resolution);
+        }
+
+        template<typename Gradient>
+        void bake(const Gradient& gradient, precision first, precision last, std::size_t resolution = 256);
+
+        // Re-samples only the entries in the key range the gradient changed since the last bake() or update()
+        // from it, e.g. the two segments around a dragged stop. The key range of the table stays the same.
+        // Returns the number of entries re-sampled.
+        template<typename Gradient>
+        std::size_t update(const Gradient& gradient);
+
+        std::uint32_t nearest(precision point) const;
+        std::uint32_t lerp(precision point) const;
+        void sample(const precision* points, std::size_t count, std::uint32_t* packed, bool interpolate = false) const;
+
+        bool empty() const { return this->table.empty(); }
+        std::size_t size() const { return this->table.size(); }
+        const std::uint32_t* data() const { return this->table.data(); }
+        precision firstKey() const { return this->first; }
+        precision lastKey() const { return this->last; }
+
+    private:
+        // Table position of point, clamped to [0, size() - 1]
+        precision position(precision point) const;
+
+        // Evaluates entries [begin, end)
+        template<typename Gradient>
+        void resample(const Gradient& gradient, std::size_t begin, std::size_t end);
+
+        std::vector<std::uint32_t> table;
+        precision first = precision(0);
+        precision last = precision(0);
+        precision scale = precision(0);
+        std::uint64_t sourceVersion = 0;
+    };
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// BakedGradient implementation  ////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+namespace gradient {
+
+    template<typename precision>
+    template<typename Gradient>
+    void BakedGradient<precision>::bake(const Gradient& gradient, precision first, precision last, std::size_t resolution) {
+        GRADIENT_METRICS_SCOPE(Bake, resolution);
+        GRADIENT_METRICS_ALLOCS(Bake, 1);
+        assert(resolution >= 2);
+        this->first = first;
+        this->last = last;
+        this->scale = last > first ? precision(resolution - 1) / (last - first) : precision(0);
+        this->sourceVersion = detail::version_of(gradient, 0);
+
+        this->table.resize(resolution);
+        this->resample(gradient, 0, resolution);
+    }
+
+    template<typename precision>
+    template<typename Gradient>
+    std::size_t BakedGradient<precision>::update(const Gradient& gradient) {
+        assert(!this->table.empty());
+        const KeyRange<precision> changed = gradient.changedSince(this->sourceVersion);
+        this->sourceVersion = gradient.version();
+        if (changed.empty() || changed.last < this->first || changed.first > this->last) {
+            return 0;
+        }
+
+        // One extra entry on each side absorbs the rounding of the positions
+        const precision lo = std::max(changed.first, this->first);
+        const precision hi = std::min(changed.last, this->last);
+        const std::size_t begin = std::size_t(std::max(this->position(lo) - precision(1), precision(0)));
+        const std::size_t end = std::min(std::size_t(this->position(hi)) + 2, this->table.size());
+        GRADIENT_METRICS_SCOPE(Bake, end - begin);
+        this->resample(gradient, begin, end);
+        return end - begin;
+    }
+
+    namespace detail {
+        // Packed batch through the scratch overload when the gradient has one, so a LinearGradient
+        // evaluated block by block flattens its stops once
+        template<typename Gradient, typename precision>
+        auto evaluate_packed(const Gradient& gradient, const precision* points, std::size_t count, std::uint32_t* packed, BatchScratch<precision>& scratch, int)
+            -> decltype(gradient.evaluate(points, count, packed, scratch)) { gradient.evaluate(points, count, packed, scratch); }
+        template<typename Gradient, typename precision>
+        void evaluate_packed(const Gradient& gradient, const precision* points, std::size_t count, std::uint32_t* packed, BatchScratch<precision>&, long) {
+            gradient.evaluate(points, count, packed);
+        }
+    }
+
+    template<typename precision>
+    template<typename Gradient>
+    void BakedGradient<precision>::resample(const Gradient& gradient, std::size_t begin, std::size_t end) {
+        // Points on the stack, one block at a time
+        const std::size_t resolution = this->table.size();
+        precision points[detail::batch_block];
+        BatchScratch<precision> scratch;
+        for (std::size_t first = begin; first < end; first += detail::batch_block) {
+            const std::size_t n = std::min(detail::batch_block, end - first);
+            for (std::size_t i = 0; i < n; i++) {
+                points[i] = this->first + (this->last - this->first) * precision(first + i) / precision(resolution - 1);
+            }
+            detail::evaluate_packed(gradient, points, n, this->table.data() + first, scratch, 0);
+        }
+    }
+
+    template<typename precision>
+    precision BakedGradient<precision>::position(precision point) const {
+        const precision x = (point - this->first) * this->scale;
+        const precision end = precision(this->table.size() - 1);
+        return x > precision(0) ? (x < end ? x : end) : precision(0);
+    }
+
+    template<typename precision>
+    std::uint32_t BakedGradient<precision>::nearest(precision point) const {
+        assert(!this->table.empty());
+        GRADIENT_METRICS_HITS(BakedLookup, 1);
+        return this->table[std::size_t(this->position(point) + precision(0.5))];
+    }
+
+    template<typename precision>
+    std::uint32_t BakedGradient<precision>::lerp(precision point) const {
+        assert(!this->table.empty());
+        GRADIENT_METRICS_HITS(BakedLookup, 1);
+        const precision x = this->position(point);
+        const std::size_t i = std::min(std::size_t(x), this->table.size() - 2);
+        const std::uint32_t w = std::uint32_t((x - precision(i)) * precision(256) + precision(0.5));
+
+        // Two channels per 32-bit multiply, each 16-bit lane holds at most 255 * 256
+        const std::uint32_t a = this->table[i];
+        const std::uint32_t b = this->table[i + 1];
+        const std::uint32_t rb = (((a & 0x00FF00FFu) * (256 - w) + (b & 0x00FF00FFu) * w) >> 8) & 0x00FF00FFu;
+        const std::uint32_t ga = (((a >> 8) & 0x00FF00FFu) * (256 - w) + ((b >> 8) & 0x00FF00FFu) * w) & 0xFF00FF00u;
+        return rb | ga;
+    }
+
+    template<typename precision>
+    void BakedGradient<precision>::sample(const precision* points, std::size_t count, std::uint32_t* packed, bool interpolate) const {
+        GRADIENT_METRICS_SCOPE(BakedLookup, count);
+        if (interpolate) {
+            for (std::size_t i = 0; i < count; i++) {
+                packed[i] = this->lerp(points[i]);
+            }
+        } else {
+            for (std::size_t i = 0; i < count; i++) {
+                packed[i] = this->nearest(points[i]);
+            }
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// GradientSnapshot  ////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+namespace gradient {
+
+    namespace detail {
+        template<typename T, typename precision, typename Interp>
+        Interpolation<precision> curve_function(const GradientBase<T, precision, Interp>&) {
+            return &Interp::template apply<precision>;
+        }
+
+        template<typename T, typename precision>
+        Interpolation<precision> curve_function(const GradientBase<T, precision, DynamicInterp>& gradient) {
+            return gradient.interpolation();
+        }
+    }
+
+    // Read-only copy of a gradient's stops and curve, flattened once. Nothing in it is mutable after
+    // construction, so one snapshot (e.g. behind a std::shared_ptr<const GradientSnapshot<>>) can be
+    // evaluated from any number of threads while the UI thread keeps editing the source gradient.
+    // A custom interpolation is copied and must itself be safe to call concurrently.
+    template<typename precision>
+    class GradientSnapshot {
+    public:
+        using key_type = precision;
+
+        template<typename Gradient>
+        explicit GradientSnapshot(const Gradient& gradient)
+            : stops(flatten(gradient)),
+              interpolation(detail::curve_function(gradient)),
+              kind(gradient.curveKind()),
+              scale(float(255.0 / color_traits<typename Gradient::color_type>::max())) {
+            assert(this->stops.size() > 0);
+        }
+
+        // Same output as the source's evaluate(), see LinearGradient
+        void evaluate(const precision* points, std::size_t count, float* rgba) const {
+            GRADIENT_METRICS_SCOPE(GradientBatch, count);
+            detail::evaluate_batch(this->stops.view(), *this, points, count, rgba);
+        }
+
+        void evaluate(const precision* points, std::size_t count, std::uint32_t* packed) const {
+            GRADIENT_METRICS_SCOPE(GradientBatch, count);
+            detail::evaluate_batch(this->stops.view(), *this, points, count, this->scale, packed);
+        }
+
+        // Already flat, the scratch is not used
+        void evaluate(const precision* points, std::size_t count, float* rgba, BatchScratch<precision>&) const { this->evaluate(points, count, rgba); }
+        void evaluate(const precision* points, std::size_t count, std::uint32_t* packed, BatchScratch<precision>&) const { this->evaluate(points, count, packed); }
+
+        precision curve(precision r) const { return this->interpolation(r); }
+        detail::Ease curveKind() const { return this->kind; }
+
+        std::size_t size() const { return this->stops.size(); }
+        precision firstKey() const { return this->stops.view().keys[0]; }
+        precision lastKey() const { return this->stops.view().keys[this->stops.size() - 1]; }
+
+        template<typename Visitor>
+        void forEachKey(Visitor visit) const {
+            const detail::StopsView<precision> view = this->stops.view();
+            for (std::size_t i = 0; i < view.size; i++) {
+                visit(view.keys[i]);
+            }
+        }
+
+    private:
+        template<typename Gradient>
+        static detail::FlatStops<precision> flatten(const Gradient& gradient) {
+            detail::FlatStops<precision> flat;
+            flat.assign(gradient);
+            return flat;
+        }
+
+        const detail::FlatStops<precision> stops;
+        const Interpolation<precision> interpolation;
+        const detail::Ease kind;
+        const float scale;
+    };
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// User-Defined Types  //////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+namespace gradient {
+
+    using Color = std::valarray<GRADIENT_COLOR_PRECISION_TYPE>;
+    using LinearColorGradient = LinearGradient<Color>;
+    using FlatLinearColorGradient = FlatLinearGradient<Color>;
+
+    // RGBA color in 0-1 floats with the same layout as ImVec4: trivially copyable, no heap,
+    // and arithmetic works in place of the valarray temporaries of Color.
+    struct Color4 {
+        float r, g, b, a;
+
+        std::size_t size() const { return 4; }
+        float& operator[](std::size_t i) { return (&r)[i]; }
+        const float& operator[](std::size_t i) const { return (&r)[i]; }
+    };
+
+    static_assert(sizeof(Color4) == 16, "Color4 must match the layout of 4 floats");
+
+    inline Color4 operator+(const Color4& lhs, const Color4& rhs) { return Color4{lhs.r + rhs.r, lhs.g + rhs.g, lhs.b + rhs.b, lhs.a + rhs.a}; }
+    inline Color4 operator-(const Color4& lhs, const Color4& rhs) { return Color4{lhs.r - rhs.r, lhs.g - rhs.g, lhs.b - rhs.b, lhs.a - rhs.a}; }
+    inline Color4 operator*(const Color4& lhs, float rhs) { return Color4{lhs.r * rhs, lhs.g * rhs, lhs.b * rhs, lhs.a * rhs}; }
+    inline Color4 operator*(float lhs, const Color4& rhs) { return rhs * lhs; }
+    inline Color4 operator*(const Color4& lhs, double rhs) { return lhs * float(rhs); }
+    inline Color4 operator*(double lhs, const Color4& rhs) { return rhs * float(lhs); }
+
+    template<>
+    struct color_traits<Color4> {
+        static double max() { return 1.0; }
+    };
+
+    namespace detail {
+        template<> struct rgba_layout<Color4> { static constexpr bool value = true; };
+        static_assert(sizeof(Color4) == 4 * sizeof(float), "Color4 is read as 4 floats by the batch kernels");
+    }
+
+    // GRADIENT_SEPARATE_IMPLEMENTATION: the common instantiations are compiled once, in the translation unit
+    // that also defines GRADIENT_IMPLEMENTATION, instead of in every one that uses them
+#if defined(GRADIENT_SEPARATE_IMPLEMENTATION) && !defined(GRADIENT_IMPLEMENTATION)
+#define GRADIENT_INSTANTIATE extern template
+#elif defined(GRADIENT_IMPLEMENTATION)
+#define GRADIENT_INSTANTIATE template
+#endif
+
+#if defined(GRADIENT_INSTANTIATE)
+    GRADIENT_INSTANTIATE class GradientBase<Color, default_precision>;
+    GRADIENT_INSTANTIATE class LinearGradient<Color>;
+    GRADIENT_INSTANTIATE class FlatLinearGradient<Color>;
+    GRADIENT_INSTANTIATE class GradientBase<Color4, float>;
+    GRADIENT_INSTANTIATE class LinearGradient<Color4, float>;
+    GRADIENT_INSTANTIATE class FlatLinearGradient<Color4, float>;
+    GRADIENT_INSTANTIATE class BakedGradient<default_precision>;
+#undef GRADIENT_INSTANTIATE
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Color spaces  ////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+// Interpolating gamma-encoded sRGB gives muddy midpoints, linear sRGB and OKLab give even ones.
+// Stops are converted once when they are set, so each sample only pays for the conversion back:
+// a table lookup per channel for linear sRGB, plus two 3x3 matrices and three cubes for OKLab.
+
+namespace gradient {
+
+    enum class ColorSpace { SRGB, LinearSRGB, OKLab };
+
+    inline float srgb_to_linear_exact(float c) {
+        return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+    }
+
+    inline float linear_to_srgb_exact(float c) {
+        return c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+    }
+
+    namespace detail {
+
+        // Sampled transfer functions, read with linear interpolation. Max absolute error against the
+        // exact functions on [0, 1]: 5.4e-7 to linear (1024 entries), 1.7e-5 to sRGB (4096 entries).
+        struct TransferTables {
+            static constexpr int toLinearSize = 1024;
+            static constexpr int toSRGBSize = 4096;
+            float toLinear[toLinearSize + 1];
+            float toSRGB[toSRGBSize + 1];
+
+            TransferTables() {
+                for (int i = 0; i <= toLinearSize; i++) {
+                    this->toLinear[i] = srgb_to_linear_exact(float(i) / toLinearSize);
+                }
+                for (int i = 0; i <= toSRGBSize; i++) {
+                    this->toSRGB[i] = linear_to_srgb_exact(float(i) / toSRGBSize);
+                }
+            }
+        };
+
+        inline const TransferTables& transfer_tables() {
+            static const TransferTables tables;
+            return tables;
+        }
+
+        inline float sample_table(const float* table, int size, float x) {
+            x = std::min(std::max(x, 0.0f), 1.0f) * float(size);
+            const int i = std::min(int(x), size - 1);
+            const float f = x - float(i);
+            return table[i] + (table[i + 1] - table[i]) * f;
+        }
+    }
+
+    inline float srgb_to_linear(float c) {
+        const detail::TransferTables& tables = detail::transfer_tables();
+        return detail::sample_table(tables.toLinear, detail::TransferTables::toLinearSize, c);
+    }
+
+    inline float linear_to_srgb(float c) {
+        const detail::TransferTables& tables = detail::transfer_tables();
+        return detail::sample_table(tables.toSRGB, detail::TransferTables::toSRGBSize, c);
+    }
+
+    // https://bottosson.github.io/posts/oklab/
+    inline Color4 linear_srgb_to_oklab(const Color4& c) {
+        const float l = std::cbrt(0.4122214708f * c.r + 0.5363325363f * c.g + 0.0514459929f * c.b);
+        const float m = std::cbrt(0.2119034982f * c.r + 0.6806995451f * c.g + 0.1073969566f * c.b);
+        const float s = std::cbrt(0.0883024619f * c.r + 0.2817188376f * c.g + 0.6299787005f * c.b);
+        return Color4{0.2104542553f * l + 0.7936177850f * m - 0.0040720468f * s,
+                      1.9779984951f * l - 2.4285922050f * m + 0.4505937099f * s,
+                      0.0259040371f * l + 0.7827717662f * m - 0.8086757660f * s,
+                      c.a};
+    }
+
+    inline Color4 oklab_to_linear_srgb(const Color4& c) {
+        const float l_ = c.r + 0.3963377774f * c.g + 0.2158037573f * c.b;
+        const float m_ = c.r - 0.1055613458f * c.g - 0.0638541728f * c.b;
+        const float s_ = c.r - 0.0894841775f * c.g - 1.2914855480f * c.b;
+        const float l = l_ * l_ * l_;
+        const float m = m_ * m_ * m_;
+        const float s = s_ * s_ * s_;
+        return Color4{ 4.0767416621f * l - 3.3077115913f * m + 0.2309699292f * s,
+                      -1.2684380046f * l + 2.6097574011f * m - 0.3413193965f * s,
+                      -0.0041960863f * l - 0.7034186147f * m + 1.7076147010f * s,
+                       c.a};
+    }
+
+    // sRGB (0-1) into the given space, alpha is left as is
+    inline Color4 to_color_space(const Color4& srgb, ColorSpace space) {
+        if (space == ColorSpace::SRGB) {
+            return srgb;
+        }
+        const Color4 linear{srgb_to_linear(srgb.r), srgb_to_linear(srgb.g), srgb_to_linear(srgb.b), srgb.a};
+        return space == ColorSpace::OKLab ? linear_srgb_to_oklab(linear) : linear;
+    }
+
+    inline Color4 from_color_space(const Color4& color, ColorSpace space) {
+        if (space == ColorSpace::SRGB) {
+            return color;
+        }
+        const Color4 linear = space == ColorSpace::OKLab ? oklab_to_linear_srgb(color) : color;
+        return Color4{linear_to_srgb(linear.r), linear_to_srgb(linear.g), linear_to_srgb(linear.b), linear.a};
+    }
+
+    // In place, 4 floats per color
+    inline void from_color_space(float* rgba, std::size_t count, ColorSpace space) {
+        if (space == ColorSpace::SRGB) {
+            return;
+        }
+        for (std::size_t i = 0; i < count; i++) {
+            Color4 color{rgba[4 * i], rgba[4 * i + 1], rgba[4 * i + 2], rgba[4 * i + 3]};
+            color = from_color_space(color, space);
+            rgba[4 * i] = color.r;
+            rgba[4 * i + 1] = color.g;
+            rgba[4 * i + 2] = color.b;
+            rgba[4 * i + 3] = color.a;
+        }
+    }
+
+    // Wraps a Color4 gradient (e.g. FlatLinearColor4Gradient) so that it interpolates in another color space.
+    // Stops are given and returned in sRGB; set() converts them once, evaluation converts back.
+    // The stops are stored converted, so operator[] returns a StopRef that converts on assignment and on read
+    // instead of a Color4 reference.
+    template<typename Gradient>
+    class ColorSpaceGradient {
+    public:
+        using key_type = typename Gradient::key_type;
+
+        class StopRef {
+        public:
+            StopRef& operator=(const Color4& srgb) {
+                this->stop = to_color_space(srgb, this->space);
+                return *this;
+            }
+            StopRef& operator=(const StopRef& other) { return *this = Color4(other); }
+            operator Color4() const { return from_color_space(this->stop, this->space); }
+
+        private:
+            friend class ColorSpaceGradient;
+            StopRef(Color4& stop, ColorSpace space) : stop(stop), space(space) {}
+
+            Color4& stop;
+            ColorSpace space;
+        };
+
+        explicit ColorSpaceGradient(ColorSpace space = ColorSpace::OKLab) : space(space) {}
+
+        void set(key_type keyPoint, const Color4& srgb) { this->gradient.set(keyPoint, to_color_space(srgb, this->space)); }
+        Color4 operator()(key_type point) const { return from_color_space(this->gradient(point), this->space); }
+
+        // Like the other gradients, a missing key point is added
+        StopRef operator[](key_type keyPoint) { return StopRef(this->gradient[keyPoint], this->space); }
+        Color4 operator[](key_type keyPoint) const { return from_color_space(this->gradient[keyPoint], this->space); }
+
+        void evaluate(const key_type* points, std::size_t count, float* rgba) const {
+            this->gradient.evaluate(points, count, rgba);
+            from_color_space(rgba, count, this->space);
+        }
+
+        void evaluate(const key_type* points, std::size_t count, std::uint32_t* packed) const {
+            BatchScratch<key_type> scratch;
+            this->evaluate(points, count, packed, scratch);
+        }
+
+        void evaluate(const key_type* points, std::size_t count, float* rgba, BatchScratch<key_type>& scratch) const {
+            this->gradient.evaluate(points, count, rgba, scratch);
+            from_color_space(rgba, count, this->space);
+        }
+
+        void evaluate(const key_type* points, std::size_t count, std::uint32_t* packed, BatchScratch<key_type>& scratch) const {
+            float rgba[4 * detail::batch_block];
+            for (std::size_t first = 0; first < count; first += detail::batch_block) {
+                const std::size_t n = std::min(detail::batch_block, count - first);
+                this->evaluate(points + first, n, rgba, scratch);
+                detail::pack_rgba8(rgba, n, 255.0f, packed + first);
+            }
+        }
+
+        std::size_t size() const { return this->gradient.size(); }
+        key_type firstKey() const { return this->gradient.firstKey(); }
+        key_type lastKey() const { return this->gradient.lastKey(); }
+        template<typename Visitor> void forEachKey(Visitor visit) const { this->gradient.forEachKey(visit); }
+        ColorSpace colorSpace() const { return this->space; }
+
+        bool erase(key_type keyPoint) { return this->gradient.erase(keyPoint); }
+        bool move(key_type from, key_type to) { return this->gradient.move(from, to); }
+        std::uint64_t version() const { return this->gradient.version(); }
+        KeyRange<key_type> changedSince(std::uint64_t version) const { return this->gradient.changedSince(version); }
+
+        // Stops in the working color space
+        const Gradient& base() const { return this->gradient; }
+
+    private:
+        Gradient gradient;
+        ColorSpace space;
+    };
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// HSV and HSL  /////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+// Conversions between sRGB and HSV / HSL, in two flavours:
+//   float        hue in turns (wrapped), other channels 0-1, 4 floats per color, alpha is copied as is
+//   fixed-point  packed RGBA8 (R in the low byte, as pack_rgba8()) and HSV8 / HSL8, integer math only:
+//                hue in 1/1536 turns, 256 steps per sixth of the wheel like RainbowP() in candy.h
+// Every channel is the max channel minus chroma * ramp(hue), evaluated without branches, so the batch
+// versions run the scalar code on 4 colors at once (SSE2/NEON) and give identical results (again, as long
+// as the scalar float code is not contracted into FMAs, e.g. by -march=native with GCC).
+// The fixed-point RGB to HSV/HSL divisions are done in float on the vector path: the operands stay below
+// 2^18 and the quotients below 513, so the truncated float quotient equals the integer one.
+
+namespace gradient {
+
+    constexpr int hue8_steps = 1536;
+
+    // Hue in 1/hue8_steps turns, h < hue8_steps; s, v / l in 0-255
+    struct HSV8 { std::uint16_t h; std::uint8_t s, v; };
+    struct HSL8 { std::uint16_t h; std::uint8_t s, l; };
+
+    static_assert(sizeof(HSV8) == 4 && sizeof(HSL8) == 4, "HSV8 and HSL8 must pack into 32 bits");
+
+    namespace detail {
+
+        // Hue in [0, 6) from r, g, b, their max and chroma, 0 for grays
+        inline float hue6(float r, float g, float b, float max, float c) {
+            const float inv = c > 0.0f ? 1.0f / c : 0.0f;
+            float hr = (g - b) * inv;
+            hr = hr < 0.0f ? hr + 6.0f : hr;
+            const float hg = (b - r) * inv + 2.0f;
+            const float hb = (r - g) * inv + 4.0f;
+            return max == r ? hr : max == g ? hg : hb;
+        }
+
+        // r, g, b of hue h (turns) with the given max channel and chroma
+        inline void hue_to_rgb(float h, float max, float c, float* rgb) {
+            const float h6 = (h - std::floor(h)) * 6.0f;
+            for (int i = 0; i < 3; i++) {
+                float k = float(5 - 2 * i) + h6;
+                k = k >= 6.0f ? k - 6.0f : k;
+                const float w = std::min(std::max(std::min(k, 4.0f - k), 0.0f), 1.0f);
+                rgb[i] = max - c * w;
+            }
+        }
+
+        // round(x / 255) for x in [0, 65025]
+        inline int div255(int x) {
+            x += 128;
+            return (x + (x >> 8)) >> 8;
+        }
+
+        // Hue in 1/1536 turns from r, g, b (0-255), their max and chroma, 0 for grays
+        inline int hue8(int r, int g, int b, int max, int c) {
+            const int d = max == r ? g - b : max == g ? b - r : r - g;
+            const int base = max == r ? 0 : max == g ? 512 : 1024;
+            int h = base - 256 + (512 * (d + c) + c) / std::max(2 * c, 1);
+            h = h < 0 ? h + hue8_steps : h;
+            return c > 0 ? h : 0;
+        }
+
+        // Packed r, g, b of hue h (1/1536 turns) with the given max channel and chroma (0-255).
+        // At full chroma each channel is the ramp of RainbowP(): w runs 0-255 over one sixth.
+        inline std::uint32_t hue8_to_rgb8(int h, int max, int c) {
+            std::uint32_t rgb = 0;
+            for (int i = 0; i < 3; i++) {
+                int k = (5 - 2 * i) * 256 + h;
+                k = k >= hue8_steps ? k - hue8_steps : k;
+                const int w = std::min(std::max(std::min(k, 1023 - k), 0), 255);
+                rgb |= std::uint32_t(max - div255(c * w)) << (8 * i);
+            }
+            return rgb;
+        }
+
+        inline int hsl8_chroma_range(int l) { return 255 - std::abs(2 * l - 255); }
+    }
+
+    inline Color4 rgb_to_hsv(const Color4& rgb) {
+        const float max = std::max(std::max(rgb.r, rgb.g), rgb.b);
+        const float min = std::min(std::min(rgb.r, rgb.g), rgb.b);
+        const float c = max - min;
+        return Color4{detail::hue6(rgb.r, rgb.g, rgb.b, max, c) * (1.0f / 6.0f), max > 0.0f ? c / max : 0.0f, max, rgb.a};
+    }
+
+    inline Color4 hsv_to_rgb(const Color4& hsv) {
+        Color4 rgb{0.0f, 0.0f, 0.0f, hsv.a};
+        detail::hue_to_rgb(hsv.r, hsv.b, hsv.b * hsv.g, &rgb.r);
+        return rgb;
+    }
+
+    inline Color4 rgb_to_hsl(const Color4& rgb) {
+        const float max = std::max(std::max(rgb.r, rgb.g), rgb.b);
+        const float min = std::min(std::min(rgb.r, rgb.g), rgb.b);
+        const float c = max - min;
+        const float sum = max + min;
+        const float range = 1.0f - std::abs(sum - 1.0f);
+        return Color4{detail::hue6(rgb.r, rgb.g, rgb.b, max, c) * (1.0f / 6.0f), range > 0.0f ? c / range : 0.0f, sum * 0.5f, rgb.a};
+    }
+
+    inline Color4 hsl_to_rgb(const Color4& hsl) {
+        const float c = (1.0f - std::abs(2.0f * hsl.b - 1.0f)) * hsl.g;
+        Color4 rgb{0.0f, 0.0f, 0.0f, hsl.a};
+        detail::hue_to_rgb(hsl.r, hsl.b + c * 0.5f, c, &rgb.r);
+        return rgb;
+    }
+
+    // Round trips are within 1 per channel through HSV8 and within 2 through HSL8 (s and l are both rounded)
+    inline HSV8 rgba8_to_hsv8(std::uint32_t rgba) {
+        const int r = int(rgba & 0xFF), g = int((rgba >> 8) & 0xFF), b = int((rgba >> 16) & 0xFF);
+        const int max = std::max(std::max(r, g), b);
+        const int c = max - std::min(std::min(r, g), b);
+        return HSV8{std::uint16_t(detail::hue8(r, g, b, max, c)), std::uint8_t((255 * c + (max >> 1)) / std::max(max, 1)), std::uint8_t(max)};
+    }
+
+    inline std::uint32_t hsv8_to_rgba8(HSV8 hsv, std::uint8_t alpha = 255) {
+        return detail::hue8_to_rgb8(hsv.h, hsv.v, detail::div255(hsv.v * hsv.s)) | (std::uint32_t(alpha) << 24);
+    }
+
+    inline HSL8 rgba8_to_hsl8(std::uint32_t rgba) {
+        const int r = int(rgba & 0xFF), g = int((rgba >> 8) & 0xFF), b = int((rgba >> 16) & 0xFF);
+        const int max = std::max(std::max(r, g), b);
+        const int min = std::min(std::min(r, g), b);
+        const int c = max - min;
+        const int range = 255 - std::abs(max + min - 255);
+        return HSL8{std::uint16_t(detail::hue8(r, g, b, max, c)), std::uint8_t((255 * c + (range >> 1)) / std::max(range, 1)), std::uint8_t((max + min + 1) >> 1)};
+    }
+
+    inline std::uint32_t hsl8_to_rgba8(HSL8 hsl, std::uint8_t alpha = 255) {
+        const int c = detail::div255(hsl.s * detail::hsl8_chroma_range(hsl.l));
+        return detail::hue8_to_rgb8(hsl.h, hsl.l + (c >> 1), c) | (std::uint32_t(alpha) << 24);
+    }
+}
+
+// Vector paths of the batch conversions, AArch64 only on ARM (vdivq_f32)
+#if defined(GRADIENT_SIMD_SSE2) || (defined(GRADIENT_SIMD_NEON) && (defined(__aarch64__) || defined(_M_ARM64)))
+#define GRADIENT_SIMD_HUE
+
+namespace gradient {
+
+    namespace detail {
+
+        // The few 4-lane operations the hue kernels need, so that each kernel is written once.
+        // Comparisons return all-ones / all-zeros lane masks of the compared type.
+        namespace x4 {
+#if defined(GRADIENT_SIMD_SSE2)
+            using f32 = __m128;
+            using i32 = __m128i;
+
+            inline f32 set(float v) { return _mm_set1_ps(v); }
+            inline f32 add(f32 a, f32 b) { return _mm_add_ps(a, b); }
+            inline f32 sub(f32 a, f32 b) { return _mm_sub_ps(a, b); }
+            inline f32 mul(f32 a, f32 b) { return _mm_mul_ps(a, b); }
+            inline f32 div(f32 a, f32 b) { return _mm_div_ps(a, b); }
+            inline f32 min(f32 a, f32 b) { return _mm_min_ps(a, b); }
+            inline f32 max(f32 a, f32 b) { return _mm_max_ps(a, b); }
+            inline f32 abs(f32 a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+            inline f32 lt(f32 a, f32 b) { return _mm_cmplt_ps(a, b); }
+            inline f32 eq(f32 a, f32 b) { return _mm_cmpeq_ps(a, b); }
+            inline f32 mask(f32 m, f32 a) { return _mm_and_ps(m, a); }
+            inline f32 select(f32 m, f32 a, f32 b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+
+            // Same as std::floor for |a| < 2^31
+            inline f32 floor(f32 a) {
+                const f32 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
+                return _mm_sub_ps(t, _mm_and_ps(_mm_cmplt_ps(a, t), _mm_set1_ps(1.0f)));
+            }
+
+            // 4 RGBA colors to one register per channel and back
+            inline void load(const float* p, f32& r, f32& g, f32& b, f32& a) {
+                r = _mm_loadu_ps(p); g = _mm_loadu_ps(p + 4); b = _mm_loadu_ps(p + 8); a = _mm_loadu_ps(p + 12);
+                _MM_TRANSPOSE4_PS(r, g, b, a);
+            }
+
+            inline void store(float* p, f32 r, f32 g, f32 b, f32 a) {
+                _MM_TRANSPOSE4_PS(r, g, b, a);
+                _mm_storeu_ps(p, r); _mm_storeu_ps(p + 4, g); _mm_storeu_ps(p + 8, b); _mm_storeu_ps(p + 12, a);
+            }
+
+            inline i32 set(int v) { return _mm_set1_epi32(v); }
+            inline i32 add(i32 a, i32 b) { return _mm_add_epi32(a, b); }
+            inline i32 sub(i32 a, i32 b) { return _mm_sub_epi32(a, b); }
+            // Both factors in [0, 32767]
+            inline i32 mul(i32 a, i32 b) { return _mm_madd_epi16(a, b); }
+            inline i32 lt(i32 a, i32 b) { return _mm_cmplt_epi32(a, b); }
+            inline i32 eq(i32 a, i32 b) { return _mm_cmpeq_epi32(a, b); }
+            inline i32 mask(i32 m, i32 a) { return _mm_and_si128(m, a); }
+            inline i32 select(i32 m, i32 a, i32 b) { return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b)); }
+            inline i32 bit_or(i32 a, i32 b) { return _mm_or_si128(a, b); }
+            template<int n> i32 shl(i32 a) { return _mm_slli_epi32(a, n); }
+            template<int n> i32 shr(i32 a) { return _mm_srli_epi32(a, n); }
+            inline f32 to_float(i32 a) { return _mm_cvtepi32_ps(a); }
+            inline i32 to_int(f32 a) { return _mm_cvttps_epi32(a); }
+            inline i32 load(const void* p) { return _mm_loadu_si128(static_cast<const __m128i*>(p)); }
+            inline void store(void* p, i32 a) { _mm_storeu_si128(static_cast<__m128i*>(p), a); }
+#else
+            using f32 = float32x4_t;
+            using i32 = int32x4_t;
+
+            inline f32 set(float v) { return vdupq_n_f32(v); }
+            inline f32 add(f32 a, f32 b) { return vaddq_f32(a, b); }
+            inline f32 sub(f32 a, f32 b) { return vsubq_f32(a, b); }
+            inline f32 mul(f32 a, f32 b) { return vmulq_f32(a, b); }
+            inline f32 div(f32 a, f32 b) { return vdivq_f32(a, b); }
+            inline f32 min(f32 a, f32 b) { return vminq_f32(a, b); }
+            inline f32 max(f32 a, f32 b) { return vmaxq_f32(a, b); }
+            inline f32 abs(f32 a) { return vabsq_f32(a); }
+            inline f32 lt(f32 a, f32 b) { return vreinterpretq_f32_u32(vcltq_f32(a, b)); }
+            inline f32 eq(f32 a, f32 b) { return vreinterpretq_f32_u32(vceqq_f32(a, b)); }
+            inline f32 mask(f32 m, f32 a) { return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(m), vreinterpretq_u32_f32(a))); }
+            inline f32 select(f32 m, f32 a, f32 b) { return vbslq_f32(vreinterpretq_u32_f32(m), a, b); }
+
+            // Same as std::floor for |a| < 2^31
+            inline f32 floor(f32 a) {
+                const f32 t = vcvtq_f32_s32(vcvtq_s32_f32(a));
+                return vsubq_f32(t, mask(lt(a, t), vdupq_n_f32(1.0f)));
+            }
+
+            inline void load(const float* p, f32& r, f32& g, f32& b, f32& a) {
+                const float32x4x4_t v = vld4q_f32(p);
+                r = v.val[0]; g = v.val[1]; b = v.val[2]; a = v.val[3];
+            }
+
+            inline void store(float* p, f32 r, f32 g, f32 b, f32 a) {
+                float32x4x4_t v;
+                v.val[0] = r; v.val[1] = g; v.val[2] = b; v.val[3] = a;
+                vst4q_f32(p, v);
+            }
+
+            inline i32 set(int v) { return vdupq_n_s32(v); }
+            inline i32 add(i32 a, i32 b) { return vaddq_s32(a, b); }
+            inline i32 sub(i32 a, i32 b) { return vsubq_s32(a, b); }
+            inline i32 mul(i32 a, i32 b) { return vmulq_s32(a, b); }
+            inline i32 lt(i32 a, i32 b) { return vreinterpretq_s32_u32(vcltq_s32(a, b)); }
+            inline i32 eq(i32 a, i32 b) { return vreinterpretq_s32_u32(vceqq_s32(a, b)); }
+            inline i32 mask(i32 m, i32 a) { return vandq_s32(m, a); }
+            inline i32 select(i32 m, i32 a, i32 b) { return vbslq_s32(vreinterpretq_u32_s32(m), a, b); }
+            inline i32 bit_or(i32 a, i32 b) { return vorrq_s32(a, b); }
+            template<int n> i32 shl(i32 a) { return vshlq_n_s32(a, n); }
+            template<int n> i32 shr(i32 a) { return vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(a), n)); }
+            inline f32 to_float(i32 a) { return vcvtq_f32_s32(a); }
+            inline i32 to_int(f32 a) { return vcvtq_s32_f32(a); }
+            inline i32 load(const void* p) { return vld1q_s32(static_cast<const std::int32_t*>(p)); }
+            inline void store(void* p, i32 a) { vst1q_s32(static_cast<std::int32_t*>(p), a); }
+#endif
+        }
+
+        // hue6(), hue_to_rgb(), div255(), hue8() and hue8_to_rgb8() on 4 colors, same operations in the same order
+
+        inline x4::f32 hue6(x4::f32 r, x4::f32 g, x4::f32 b, x4::f32 max, x4::f32 c) {
+            const x4::f32 zero = x4::set(0.0f);
+            const x4::f32 inv = x4::mask(x4::lt(zero, c), x4::div(x4::set(1.0f), c));
+            x4::f32 hr = x4::mul(x4::sub(g, b), inv);
+            hr = x4::add(hr, x4::mask(x4::lt(hr, zero), x4::set(6.0f)));
+            const x4::f32 hg = x4::add(x4::mul(x4::sub(b, r), inv), x4::set(2.0f));
+            const x4::f32 hb = x4::add(x4::mul(x4::sub(r, g), inv), x4::set(4.0f));
+            return x4::select(x4::eq(max, r), hr, x4::select(x4::eq(max, g), hg, hb));
+        }
+
+        inline void hue_to_rgb(x4::f32 h, x4::f32 max, x4::f32 c, x4::f32* rgb) {
+            const x4::f32 zero = x4::set(0.0f);
+            const x4::f32 six = x4::set(6.0f);
+            const x4::f32 h6 = x4::mul(x4::sub(h, x4::floor(h)), six);
+            for (int i = 0; i < 3; i++) {
+                x4::f32 k = x4::add(x4::set(float(5 - 2 * i)), h6);
+                k = x4::sub(k, x4::select(x4::lt(k, six), zero, six));
+                const x4::f32 w = x4::min(x4::max(x4::min(k, x4::sub(x4::set(4.0f), k)), zero), x4::set(1.0f));
+                rgb[i] = x4::sub(max, x4::mul(c, w));
+            }
+        }
+
+        inline x4::i32 div255(x4::i32 x) {
+            x = x4::add(x, x4::set(128));
+            return x4::shr<8>(x4::add(x, x4::shr<8>(x)));
+        }
+
+        inline x4::i32 hue8(x4::i32 r, x4::i32 g, x4::i32 b, x4::i32 max, x4::i32 c) {
+            const x4::i32 zero = x4::set(0);
+            const x4::i32 isR = x4::eq(max, r);
+            const x4::i32 isG = x4::eq(max, g);
+            const x4::i32 d = x4::select(isR, x4::sub(g, b), x4::select(isG, x4::sub(b, r), x4::sub(r, g)));
+            const x4::i32 base = x4::select(isR, zero, x4::select(isG, x4::set(512), x4::set(1024)));
+            const x4::i32 num = x4::add(x4::shl<9>(x4::add(d, c)), c);
+            const x4::i32 den = x4::select(x4::lt(zero, c), x4::shl<1>(c), x4::set(1));
+            x4::i32 h = x4::add(x4::sub(base, x4::set(256)), x4::to_int(x4::div(x4::to_float(num), x4::to_float(den))));
+            h = x4::add(h, x4::mask(x4::lt(h, zero), x4::set(hue8_steps)));
+            return x4::mask(x4::lt(zero, c), h);
+        }
+
+        inline x4::i32 hue8_to_rgb8(x4::i32 h, x4::i32 max, x4::i32 c) {
+            const x4::i32 zero = x4::set(0);
+            const x4::i32 steps = x4::set(hue8_steps);
+            x4::i32 channels[3];
+            for (int i = 0; i < 3; i++) {
+                x4::i32 k = x4::add(x4::set((5 - 2 * i) * 256), h);
+                k = x4::sub(k, x4::select(x4::lt(k, steps), zero, steps));
+                const x4::i32 m = x4::select(x4::lt(k, x4::sub(x4::set(1023), k)), k, x4::sub(x4::set(1023), k));
+                const x4::i32 w = x4::select(x4::lt(m, zero), zero, x4::select(x4::lt(x4::set(255), m), x4::set(255), m));
+                channels[i] = x4::sub(max, div255(x4::mul(c, w)));
+            }
+            return x4::bit_or(channels[0], x4::bit_or(x4::shl<8>(channels[1]), x4::shl<16>(channels[2])));
+        }
+
+        // Unpacks 4 RGBA8 colors into r, g, b, their max, min and chroma
+        inline void unpack_rgb8(const std::uint32_t* rgba, x4::i32& r, x4::i32& g, x4::i32& b, x4::i32& max, x4::i32& min, x4::i32& c) {
+            const x4::i32 bytes = x4::load(rgba);
+            const x4::i32 low = x4::set(0xFF);
+            r = x4::mask(bytes, low);
+            g = x4::mask(x4::shr<8>(bytes), low);
+            b = x4::mask(x4::shr<16>(bytes), low);
+            const x4::i32 rg = x4::select(x4::lt(r, g), g, r);
+            max = x4::select(x4::lt(rg, b), b, rg);
+            const x4::i32 ng = x4::select(x4::lt(g, r), g, r);
+            min = x4::select(x4::lt(b, ng), b, ng);
+            c = x4::sub(max, min);
+        }
+
+        // Alpha bytes of 4 colors, taken from alpha_from when there is one
+        inline x4::i32 alpha8(const std::uint32_t* alpha_from, std::uint8_t alpha) {
+            return alpha_from ? x4::mask(x4::load(alpha_from), x4::shl<24>(x4::set(0xFF))) : x4::shl<24>(x4::set(alpha));
+        }
+    }
+}
+
+#endif
+
+namespace gradient {
+
+    // Batch conversions, 4 floats per color. in and out may be the same array.
+    // The vector loops end at count rounded down to 4, so the compiler sees the scalar tails run at most 3 times.
+
+    inline void rgb_to_hsv(const float* rgba, std::size_t count, float* hsva) {
+        std::size_t i = 0;
+#if defined(GRADIENT_SIMD_HUE)
+        for (const std::size_t blocks = count & ~std::size_t(3); i < blocks; i += 4) {
+            detail::x4::f32 r, g, b, a;
+            detail::x4::load(rgba + 4 * i, r, g, b, a);
+            const detail::x4::f32 max = detail::x4::max(detail::x4::max(r, g), b);
+            const detail::x4::f32 c = detail::x4::sub(max, detail::x4::min(detail::x4::min(r, g), b));
+            const detail::x4::f32 h = detail::x4::mul(detail::hue6(r, g, b, max, c), detail::x4::set(1.0f / 6.0f));
+            const detail::x4::f32 s = detail::x4::mask(detail::x4::lt(detail::x4::set(0.0f), max), detail::x4::div(c, max));
+            detail::x4::store(hsva + 4 * i, h, s, max, a);
+        }
+#endif
+        for (; i < count; i++) {
+            const Color4 hsv = rgb_to_hsv(Color4{rgba[4 * i], rgba[4 * i + 1], rgba[4 * i + 2], rgba[4 * i + 3]});
+            std::copy(&hsv.r, &hsv.r + 4, hsva + 4 * i);
+        }
+    }
+
+    inline void hsv_to_rgb(const float* hsva, std::size_t count, float* rgba) {
+        std::size_t i = 0;
+#if defined(GRADIENT_SIMD_HUE)
+        for (const std::size_t blocks = count & ~std::size_t(3); i < blocks; i += 4) {
+            detail::x4::f32 h, s, v, a, rgb[3];
+            detail::x4::load(hsva + 4 * i, h, s, v, a);
+            detail::hue_to_rgb(h, v, detail::x4::mul(v, s), rgb);
+            detail::x4::store(rgba + 4 * i, rgb[0], rgb[1], rgb[2], a);
+        }
+#endif
+        for (; i < count; i++) {
+            const Color4 rgb = hsv_to_rgb(Color4{hsva[4 * i], hsva[4 * i + 1], hsva[4 * i + 2], hsva[4 * i + 3]});
+            std::copy(&rgb.r, &rgb.r + 4, rgba + 4 * i);
+        }
+    }
+
+    inline void rgb_to_hsl(const float* rgba, std::size_t count, float* hsla) {
+        std::size_t i = 0;
+#if defined(GRADIENT_SIMD_HUE)
+        for (const std::size_t blocks = count & ~std::size_t(3); i < blocks; i += 4) {
+            detail::x4::f32 r, g, b, a;
+            detail::x4::load(rgba + 4 * i, r, g, b, a);
+            const detail::x4::f32 max = detail::x4::max(detail::x4::max(r, g), b);
+            const detail::x4::f32 min = detail::x4::min(detail::x4::min(r, g), b);
+            const detail::x4::f32 c = detail::x4::sub(max, min);
+            const detail::x4::f32 sum = detail::x4::add(max, min);
+            const detail::x4::f32 range = detail::x4::sub(detail::x4::set(1.0f), detail::x4::abs(detail::x4::sub(sum, detail::x4::set(1.0f))));
+            const detail::x4::f32 h = detail::x4::mul(detail::hue6(r, g, b, max, c), detail::x4::set(1.0f / 6.0f));
+            const detail::x4::f32 s = detail::x4::mask(detail::x4::lt(detail::x4::set(0.0f), range), detail::x4::div(c, range));
+            detail::x4::store(hsla + 4 * i, h, s, detail::x4::mul(sum, detail::x4::set(0.5f)), a);
+        }
+#endif
+        for (; i < count; i++) {
+            const Color4 hsl = rgb_to_hsl(Color4{rgba[4 * i], rgba[4 * i + 1], rgba[4 * i + 2], rgba[4 * i + 3]});
+            std::copy(&hsl.r, &hsl.r + 4, hsla + 4 * i);
+        }
+    }
+
+    inline void hsl_to_rgb(const float* hsla, std::size_t count, float* rgba) {
+        std::size_t i = 0;
+#if defined(GRADIENT_SIMD_HUE)
+        for (const std::size_t blocks = count & ~std::size_t(3); i < blocks; i += 4) {
+            detail::x4::f32 h, s, l, a, rgb[3];
+            detail::x4::load(hsla + 4 * i, h, s, l, a);
+            const detail::x4::f32 one = detail::x4::set(1.0f);
+            const detail::x4::f32 c = detail::x4::mul(detail::x4::sub(one, detail::x4::abs(detail::x4::sub(detail::x4::mul(detail::x4::set(2.0f), l), one))), s);
+            detail::hue_to_rgb(h, detail::x4::add(l, detail::x4::mul(c, detail::x4::set(0.5f))), c, rgb);
+            detail::x4::store(rgba + 4 * i, rgb[0], rgb[1], rgb[2], a);
+        }
+#endif
+        for (; i < count; i++) {
+            const Color4 rgb = hsl_to_rgb(Color4{hsla[4 * i], hsla[4 * i + 1], hsla[4 * i + 2], hsla[4 * i + 3]});
+            std::copy(&rgb.r, &rgb.r + 4, rgba + 4 * i);
+        }
+    }
+
+    namespace detail {
+
+        inline void hsv8_to_rgba8(const HSV8* hsv, std::size_t count, const std::uint32_t* alpha_from, std::uint8_t alpha, std::uint32_t* rgba) {
+            std::size_t i = 0;
+#if defined(GRADIENT_SIMD_HUE)
+            for (const std::size_t blocks = count & ~std::size_t(3); i < blocks; i += 4) {
+                const x4::i32 packed = x4::load(hsv + i);
+                const x4::i32 h = x4::mask(packed, x4::set(0xFFFF));
+                const x4::i32 s = x4::mask(x4::shr<16>(packed), x4::set(0xFF));
+                const x4::i32 v = x4::shr<24>(packed);
+                const x4::i32 a = alpha8(alpha_from ? alpha_from + i : nullptr, alpha);
+                x4::store(rgba + i, x4::bit_or(hue8_to_rgb8(h, v, div255(x4::mul(v, s))), a));
+            }
+#endif
+            for (; i < count; i++) {
+                rgba[i] = gradient::hsv8_to_rgba8(hsv[i], alpha_from ? std::uint8_t(alpha_from[i] >> 24) : alpha);
+            }
+        }
+
+        inline void hsl8_to_rgba8(const HSL8* hsl, std::size_t count, const std::uint32_t* alpha_from, std::uint8_t alpha, std::uint32_t* rgba) {
+            std::size_t i = 0;
+#if defined(GRADIENT_SIMD_HUE)
+            for (const std::size_t blocks = count & ~std::size_t(3); i < blocks; i += 4) {
+                const x4::i32 packed = x4::load(hsl + i);
+                const x4::i32 h = x4::mask(packed, x4::set(0xFFFF));
+                const x4::i32 s = x4::mask(x4::shr<16>(packed), x4::set(0xFF));
+                const x4::i32 l = x4::shr<24>(packed);
+                const x4::i32 dist = x4::sub(x4::shl<1>(l), x4::set(255));
+                const x4::i32 range = x4::sub(x4::set(255), x4::select(x4::lt(dist, x4::set(0)), x4::sub(x4::set(0), dist), dist));
+                const x4::i32 c = div255(x4::mul(s, range));
+                const x4::i32 a = alpha8(alpha_from ? alpha_from + i : nullptr, alpha);
+                x4::store(rgba + i, x4::bit_or(hue8_to_rgb8(h, x4::add(l, x4::shr<1>(c)), c), a));
+            }
+#endif
+            for (; i < count; i++) {
+                rgba[i] = gradient::hsl8_to_rgba8(hsl[i], alpha_from ? std::uint8_t(alpha_from[i] >> 24) : alpha);
+            }
+        }
+    }
+
+    // Batch fixed-point conversions. The back conversions set every alpha byte to 'alpha', or copy
+    // it from the same pixel of 'alpha_from' (which may be rgba itself).
+
+    inline void rgba8_to_hsv8(const std::uint32_t* rgba, std::size_t count, HSV8* hsv) {
+        std::size_t i = 0;
+#if defined(GRADIENT_SIMD_HUE)
+        for (const std::size_t blocks = count & ~std::size_t(3); i < blocks; i += 4) {
+            detail::x4::i32 r, g, b, max, min, c;
+            detail::unpack_rgb8(rgba + i, r, g, b, max, min, c);
+            const detail::x4::i32 num = detail::x4::add(detail::x4::sub(detail::x4::shl<8>(c), c), detail::x4::shr<1>(max));
+            const detail::x4::i32 den = detail::x4::select(detail::x4::lt(max, detail::x4::set(1)), detail::x4::set(1), max);
+            const detail::x4::i32 s = detail::x4::to_int(detail::x4::div(detail::x4::to_float(num), detail::x4::to_float(den)));
+            const detail::x4::i32 h = detail::hue8(r, g, b, max, c);
+            detail::x4::store(hsv + i, detail::x4::bit_or(h, detail::x4::bit_or(detail::x4::shl<16>(s), detail::x4::shl<24>(max))));
+        }
+#endif
+        for (; i < count; i++) {
+            hsv[i] = rgba8_to_hsv8(rgba[i]);
+        }
+    }
+
+    inline void hsv8_to_rgba8(const HSV8* hsv, std::size_t count, std::uint32_t* rgba, std::uint8_t alpha = 255) {
+        detail::hsv8_to_rgba8(hsv, count, nullptr, alpha, rgba);
+    }
+
+    inline void hsv8_to_rgba8(const HSV8* hsv, std::size_t count, const std::uint32_t* alpha_from, std::uint32_t* rgba) {
+        detail::hsv8_to_rgba8(hsv, count, alpha_from, 255, rgba);
+    }
+
+    inline void rgba8_to_hsl8(const std::uint32_t* rgba, std::size_t count, HSL8* hsl) {
+        std::size_t i = 0;
+#if defined(GRADIENT_SIMD_HUE)
+        for (const std::size_t blocks = count & ~std::size_t(3); i < blocks; i += 4) {
+            detail::x4::i32 r, g, b, max, min, c;
+            detail::unpack_rgb8(rgba + i, r, g, b, max, min, c);
+            const detail::x4::i32 sum = detail::x4::add(max, min);
+            const detail::x4::i32 dist = detail::x4::sub(sum, detail::x4::set(255));
+            const detail::x4::i32 range = detail::x4::sub(detail::x4::set(255), detail::x4::select(detail::x4::lt(dist, detail::x4::set(0)), detail::x4::sub(detail::x4::set(0), dist), dist));
+            const detail::x4::i32 num = detail::x4::add(detail::x4::sub(detail::x4::shl<8>(c), c), detail::x4::shr<1>(range));
+            const detail::x4::i32 den = detail::x4::select(detail::x4::lt(range, detail::x4::set(1)), detail::x4::set(1), range);
+            const detail::x4::i32 s = detail::x4::to_int(detail::x4::div(detail::x4::to_float(num), detail::x4::to_float(den)));
+            const detail::x4::i32 l = detail::x4::shr<1>(detail::x4::add(sum, detail::x4::set(1)));
+            const detail::x4::i32 h = detail::hue8(r, g, b, max, c);
+            detail::x4::store(hsl + i, detail::x4::bit_or(h, detail::x4::bit_or(detail::x4::shl<16>(s), detail::x4::shl<24>(l))));
+        }
+#endif
+        for (; i < count; i++) {
+            hsl[i] = rgba8_to_hsl8(rgba[i]);
+        }
+    }
+
+    inline void hsl8_to_rgba8(const HSL8* hsl, std::size_t count, std::uint32_t* rgba, std::uint8_t alpha = 255) {
+        detail::hsl8_to_rgba8(hsl, count, nullptr, alpha, rgba);
+    }
+
+    inline void hsl8_to_rgba8(const HSL8* hsl, std::size_t count, const std::uint32_t* alpha_from, std::uint32_t* rgba) {
+        detail::hsl8_to_rgba8(hsl, count, alpha_from, 255, rgba);
+    }
+
+    // Whole palettes adjusted in HSL, in and out may be the same array: hue is added (in turns),
+    // saturation is a factor (0 gray, 1 unchanged) and lightness is added (-1 black to 1 white).
+    inline void adjust_hsl(const float* rgba, std::size_t count, float hue, float saturation, float lightness, float* out) {
+        GRADIENT_METRICS_SCOPE(ColorAdjust, count);
+        hue -= std::floor(hue);
+        float hsla[4 * detail::batch_block];
+        for (std::size_t first = 0; first < count; first += detail::batch_block) {
+            const std::size_t n = std::min(detail::batch_block, count - first);
+            rgb_to_hsl(rgba + 4 * first, n, hsla);
+            for (std::size_t i = 0; i < n; i++) {
+                hsla[4 * i] += hue;
+                hsla[4 * i + 1] = std::min(std::max(hsla[4 * i + 1] * saturation, 0.0f), 1.0f);
+                hsla[4 * i + 2] = std::min(std::max(hsla[4 * i + 2] + lightness, 0.0f), 1.0f);
+            }
+            hsl_to_rgb(hsla, n, out + 4 * first);
+        }
+    }
+
+    // Fixed-point version on packed RGBA8, the amounts are rounded to 1/1536 turns, 1/256 and 1/255.
+    // Colors are within 3 per channel of the float version.
+    inline void adjust_hsl(const std::uint32_t* rgba, std::size_t count, float hue, float saturation, float lightness, std::uint32_t* out) {
+        GRADIENT_METRICS_SCOPE(ColorAdjust, count);
+        const int dh = int((hue - std::floor(hue)) * float(hue8_steps) + 0.5f) % hue8_steps;
+        const int ds = int(std::min(std::max(saturation, 0.0f), 255.0f) * 256.0f + 0.5f);
+        const int dl = int(std::floor(std::min(std::max(lightness, -1.0f), 1.0f) * 255.0f + 0.5f));
+        HSL8 hsl[detail::batch_block];
+        for (std::size_t first = 0; first < count; first += detail::batch_block) {
+            const std::size_t n = std::min(detail::batch_block, count - first);
+            rgba8_to_hsl8(rgba + first, n, hsl);
+            for (std::size_t i = 0; i < n; i++) {
+                const int h = hsl[i].h + dh;
+                hsl[i].h = std::uint16_t(h >= hue8_steps ? h - hue8_steps : h);
+                hsl[i].s = std::uint8_t(std::min((hsl[i].s * ds + 128) >> 8, 255));
+                hsl[i].l = std::uint8_t(std::min(std::max(hsl[i].l + dl, 0), 255));
+            }
+            hsl8_to_rgba8(hsl, n, rgba + first, out + first);
+        }
+    }
+
+    inline void hue_rotate(const float* rgba, std::size_t count, float turns, float* out) { adjust_hsl(rgba, count, turns, 1.0f, 0.0f, out); }
+    inline void saturate(const float* rgba, std::size_t count, float factor, float* out) { adjust_hsl(rgba, count, 0.0f, factor, 0.0f, out); }
+    inline void lighten(const float* rgba, std::size_t count, float amount, float* out) { adjust_hsl(rgba, count, 0.0f, 1.0f, amount, out); }
 
-    template class LinearGradient<Color>;
-    template void GradientBase<Color, default_precision >::setInterpolation(const Interpolation<default_precision> &interpolation);
+    inline void hue_rotate(const std::uint32_t* rgba, std::size_t count, float turns, std::uint32_t* out) { adjust_hsl(rgba, count, turns, 1.0f, 0.0f, out); }
+    inline void saturate(const std::uint32_t* rgba, std::size_t count, float factor, std::uint32_t* out) { adjust_hsl(rgba, count, 0.0f, factor, 0.0f, out); }
+    inline void lighten(const std::uint32_t* rgba, std::size_t count, float amount, std::uint32_t* out) { adjust_hsl(rgba, count, 0.0f, 1.0f, amount, out); }
 }
 
 #endif
@@ -0,0 +1,58 @@
+/*
+https://github.com/Raais/ImguiCandy
+
+MIT License
+
+Copyright (c) 2021 Raais N.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef Gradient_Fwd_H
+#define Gradient_Fwd_H
+
+// Forward declarations of gradient.h, for headers that only pass gradients around by reference or pointer.
+// Default template arguments live here, gradient.h includes this file.
+
+#define GRADIENT_KEY_DEFAULT_PRECISION double
+
+namespace gradient {
+    using default_precision = GRADIENT_KEY_DEFAULT_PRECISION;
+
+    struct LinearInterp;
+    struct CosineInterp;
+    struct FastCosineInterp;
+    struct SmoothstepInterp;
+    struct DynamicInterp;
+
+    template<typename T, typename precision, typename Interp = DynamicInterp> class GradientBase;
+    template<typename T, typename precision = default_precision, typename Interp = DynamicInterp> class LinearGradient;
+    template<typename T, typename precision = default_precision, typename Interp = DynamicInterp> class FlatLinearGradient;
+    template<typename precision = default_precision> class BakedGradient;
+    template<typename precision = default_precision> class GradientSnapshot;
+    template<typename precision = default_precision> class BatchScratch;
+    template<typename Gradient> class ColorSpaceGradient;
+
+    struct Color4;
+    enum class ColorSpace;
+
+    using LinearColor4Gradient = LinearGradient<Color4, float>;
+    using FlatLinearColor4Gradient = FlatLinearGradient<Color4, float>;
+}
+
+#endif
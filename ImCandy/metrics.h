@@ -0,0 +1,175 @@
+/*
+https://github.com/Raais/ImguiCandy
+
+MIT License
+
+Copyright (c) 2021 Raais N.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+// Counters behind IMCANDY_ENABLE_METRICS, included by candy_fwd.h. Without the define none of this is compiled
+// and the IMCANDY_METRICS_* / GRADIENT_METRICS_* hooks expand to nothing.
+
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+
+namespace ImCandy
+{
+      enum MetricsCounter
+      {
+          MetricsCounter_GradientEval,      // LinearGradient / FlatLinearGradient operator()
+          MetricsCounter_GradientBatch,     // evaluate() of LinearGradient, FlatLinearGradient and GradientSnapshot
+          MetricsCounter_Bake,
+          MetricsCounter_BakedLookup,       // BakedGradient nearest() / lerp() / sample(), every lookup is a hit
+          MetricsCounter_Rainbow,           // Rainbow(), RainbowP(), RainbowU32()
+          MetricsCounter_Gradient2,
+          MetricsCounter_Gradient3,
+          MetricsCounter_Animator,          // Animator::Animate(), hits are ids already evaluated this frame
+          MetricsCounter_Draw,              // DrawGradientRect/Line/Border
+          MetricsCounter_Colormap,          // Colormap::Map() and ColormapImage, every value is a table hit
+          MetricsCounter_ApplyTheme,        // ApplyTheme(), ThemeRegistry::Apply(), hits are skipped context applies
+          MetricsCounter_StyleTransition,
+          MetricsCounter_Bindings,
+          MetricsCounter_ThemeFile,
+          MetricsCounter_ColorAdjust,       // gradient::adjust_hsl() and the HueRotate() / Saturate() / Lighten() of candy.h
+          MetricsCounter_COUNT
+      };
+
+      // Totals of one counter over one frame. Times include nested calls (Gradient2() includes its gradient).
+      struct MetricsStats
+      {
+          uint64_t Calls;
+          uint64_t Items;           // Colors evaluated, values mapped, vertices written...
+          uint64_t Allocations;     // Heap allocations, lower bound
+          uint64_t Hits;            // Cache or lookup table hits
+          double   Milliseconds;
+      };
+
+      class Metrics
+      {
+      public:
+          enum { HistorySize = 120 };
+
+          // Ends the frame: the live counters move into GetFrame() and the histories. Called by ShowMetricsWindow(),
+          // call it yourself once per frame otherwise. Counters can be bumped from any thread meanwhile.
+          void NextFrame()
+          {
+              for (int i = 0; i < MetricsCounter_COUNT; i++)
+              {
+                  Live& live = Counters[i];
+                  MetricsStats& stats = Frame[i];
+                  stats.Calls = live.Calls.exchange(0, std::memory_order_relaxed);
+                  stats.Items = live.Items.exchange(0, std::memory_order_relaxed);
+                  stats.Allocations = live.Allocations.exchange(0, std::memory_order_relaxed);
+                  stats.Hits = live.Hits.exchange(0, std::memory_order_relaxed);
+                  stats.Milliseconds = double(live.Nanoseconds.exchange(0, std::memory_order_relaxed)) * 1e-6;
+                  HistoryMs[i][HistoryOffset] = float(stats.Milliseconds);
+                  HistoryItems[i][HistoryOffset] = float(stats.Items);
+              }
+              HistoryOffset = (HistoryOffset + 1) % HistorySize;
+          }
+
+          // Clears the live counters and the histories
+          void Reset()
+          {
+              NextFrame();
+              for (int i = 0; i < MetricsCounter_COUNT; i++)
+              {
+                  Frame[i] = MetricsStats();
+                  for (int j = 0; j < HistorySize; j++)
+                      HistoryMs[i][j] = HistoryItems[i][j] = 0.0f;
+              }
+              HistoryOffset = 0;
+          }
+
+          const MetricsStats& GetFrame(MetricsCounter counter) const { return Frame[counter]; }
+
+          // Last HistorySize frames, oldest first from GetHistoryOffset() (the layout ImGui::PlotHistogram() takes)
+          const float* GetHistoryMs(MetricsCounter counter) const { return HistoryMs[counter]; }
+          const float* GetHistoryItems(MetricsCounter counter) const { return HistoryItems[counter]; }
+          int GetHistoryOffset() const { return HistoryOffset; }
+
+          static const char* GetName(MetricsCounter counter)
+          {
+              static const char* const names[MetricsCounter_COUNT] =
+              {
+                  "Gradient eval", "Gradient batch", "Bake", "Baked lookup", "Rainbow", "Gradient2", "Gradient3",
+                  "Animator", "Draw", "Colormap", "Apply theme", "Style transition", "Bindings", "Theme file",
+                  "Color adjust",
+              };
+              return names[counter];
+          }
+
+          void AddCall(MetricsCounter counter, uint64_t items, uint64_t nanoseconds)
+          {
+              Counters[counter].Calls.fetch_add(1, std::memory_order_relaxed);
+              Counters[counter].Items.fetch_add(items, std::memory_order_relaxed);
+              Counters[counter].Nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+          }
+          void AddAllocations(MetricsCounter counter, uint64_t count) { Counters[counter].Allocations.fetch_add(count, std::memory_order_relaxed); }
+          void AddHits(MetricsCounter counter, uint64_t count) { Counters[counter].Hits.fetch_add(count, std::memory_order_relaxed); }
+
+      private:
+          struct Live
+          {
+              std::atomic<uint64_t> Calls{0}, Items{0}, Allocations{0}, Hits{0}, Nanoseconds{0};
+          };
+
+          Live         Counters[MetricsCounter_COUNT];
+          MetricsStats Frame[MetricsCounter_COUNT] = {};
+          float        HistoryMs[MetricsCounter_COUNT][HistorySize] = {};
+          float        HistoryItems[MetricsCounter_COUNT][HistorySize] = {};
+          int          HistoryOffset = 0;
+      };
+
+      inline Metrics& GetMetrics()
+      {
+          static Metrics metrics;
+          return metrics;
+      }
+
+      namespace detail
+      {
+          // Times its scope and records one call on destruction
+          class MetricsScope
+          {
+          public:
+              MetricsScope(MetricsCounter counter, uint64_t items) : Counter(counter), Items(items), Start(std::chrono::steady_clock::now()) {}
+              ~MetricsScope()
+              {
+                  const std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - Start;
+                  GetMetrics().AddCall(Counter, Items, uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+              }
+
+          private:
+              MetricsCounter Counter;
+              uint64_t Items;
+              std::chrono::steady_clock::time_point Start;
+          };
+      }
+};
+
+#define IMCANDY_METRICS_CONCAT_(a, b)           a##b
+#define IMCANDY_METRICS_CONCAT(a, b)            IMCANDY_METRICS_CONCAT_(a, b)
+#define IMCANDY_METRICS_SCOPE(counter, items)   ::ImCandy::detail::MetricsScope IMCANDY_METRICS_CONCAT(imcandy_metrics_scope_, __LINE__)(::ImCandy::MetricsCounter_##counter, uint64_t(items))
+#define IMCANDY_METRICS_ALLOCS(counter, count)  ::ImCandy::GetMetrics().AddAllocations(::ImCandy::MetricsCounter_##counter, uint64_t(count))
+#define IMCANDY_METRICS_HITS(counter, count)    ::ImCandy::GetMetrics().AddHits(::ImCandy::MetricsCounter_##counter, uint64_t(count))
@@ -0,0 +1,168 @@
+/*
+https://github.com/Raais/ImguiCandy
+
+MIT License
+
+Copyright (c) 2021 Raais N.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <stddef.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "imgui.h"
+#include "gradient.h"
+
+namespace ImCandy
+{
+      /*
+      Bulk colorization on worker threads, e.g. heatmap textures or per-row colors computed off the UI thread.
+      The gradient is only read, so give it a gradient::GradientSnapshot (or any gradient nobody edits meanwhile).
+      ---------------------------------------------------------------
+        static ImCandy::ThreadPool pool;
+        const gradient::GradientSnapshot<float> snapshot(heat_gradient);
+        ImCandy::ColorizeParallel(pool, snapshot, values.data(), values.size(), pixels.data());
+      ---------------------------------------------------------------
+      */
+
+      // Fixed set of workers running one ParallelFor() at a time, the calling thread takes chunks too
+      class ThreadPool
+      {
+      public:
+          explicit ThreadPool(unsigned int threads = std::max(1u, std::thread::hardware_concurrency()) - 1)
+          {
+              for (unsigned int i = 0; i < threads; i++)
+                  Workers.emplace_back([this] { WorkerLoop(); });
+          }
+
+          ~ThreadPool()
+          {
+              {
+                  std::lock_guard<std::mutex> lock(Mutex);
+                  Stopping = true;
+              }
+              Wake.notify_all();
+              for (std::thread& worker : Workers)
+                  worker.join();
+          }
+
+          ThreadPool(const ThreadPool&) = delete;
+          ThreadPool& operator=(const ThreadPool&) = delete;
+
+          // Threads working on a job, the caller included
+          unsigned int GetThreadCount() const { return unsigned(Workers.size()) + 1; }
+
+          // Calls fn(first, last) for consecutive ranges of at most 'chunk' items covering [0, count),
+          // returns once all of them are done. Inputs of a single chunk run on the calling thread only.
+          template<typename Fn>
+          void ParallelFor(size_t count, size_t chunk, const Fn& fn)
+          {
+              chunk = std::max<size_t>(chunk, 1);
+              if (count <= chunk || Workers.empty())
+              {
+                  for (size_t first = 0; first < count; first += chunk)
+                      fn(first, std::min(first + chunk, count));
+                  return;
+              }
+
+              std::lock_guard<std::mutex> submit(SubmitMutex);
+              {
+                  std::lock_guard<std::mutex> lock(Mutex);
+                  Job = &fn;
+                  Invoke = [](const void* job, size_t first, size_t last) { (*static_cast<const Fn*>(job))(first, last); };
+                  JobCount = count;
+                  JobChunk = chunk;
+                  Next = 0;
+                  Pending = unsigned(Workers.size());
+                  Generation++;
+              }
+              Wake.notify_all();
+
+              RunChunks();
+
+              std::unique_lock<std::mutex> lock(Mutex);
+              Done.wait(lock, [this] { return Pending == 0; });
+          }
+
+      private:
+          void RunChunks()
+          {
+              for (size_t first = Next.fetch_add(JobChunk); first < JobCount; first = Next.fetch_add(JobChunk))
+                  Invoke(Job, first, std::min(first + JobChunk, JobCount));
+          }
+
+          void WorkerLoop()
+          {
+              unsigned long long seen = 0;
+              for (;;)
+              {
+                  {
+                      std::unique_lock<std::mutex> lock(Mutex);
+                      Wake.wait(lock, [&] { return Stopping || Generation != seen; });
+                      if (Stopping)
+                          return;
+                      seen = Generation;
+                  }
+
+                  RunChunks();
+
+                  std::lock_guard<std::mutex> lock(Mutex);
+                  if (--Pending == 0)
+                      Done.notify_one();
+              }
+          }
+
+          std::vector<std::thread> Workers;
+          std::mutex SubmitMutex;
+          std::mutex Mutex;
+          std::condition_variable Wake, Done;
+
+          // Current job, written under Mutex before the workers are woken
+          const void* Job = NULL;
+          void (*Invoke)(const void*, size_t, size_t) = NULL;
+          size_t JobCount = 0;
+          size_t JobChunk = 0;
+          std::atomic<size_t> Next{0};
+          unsigned int Pending = 0;
+          unsigned long long Generation = 0;
+          bool Stopping = false;
+      };
+
+      // Colors 'count' points into out[] (IM_COL32 layout), 'chunk' points per task.
+      // Gradient is any gradient.h gradient, ideally a GradientSnapshot.
+      template<typename Gradient>
+      void ColorizeParallel(ThreadPool& pool, const Gradient& gradient, const typename Gradient::key_type* points, size_t count, ImU32* out, size_t chunk = 16384)
+      {
+          pool.ParallelFor(count, chunk, [&](size_t first, size_t last)
+          {
+              gradient.evaluate(points + first, last - first, out + first);
+#if IM_COL32_R_SHIFT != 0
+              // gradient.h packs R in the low byte
+              for (size_t i = first; i < last; i++)
+                  out[i] = (out[i] & 0xFF00FF00) | ((out[i] & 0xFF) << 16) | ((out[i] >> 16) & 0xFF);
+#endif
+          });
+      }
+};
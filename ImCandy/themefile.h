@@ -0,0 +1,612 @@
+/*
+https://github.com/Raais/ImguiCandy
+
+MIT License
+
+Copyright (c) 2021 Raais N.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "candy.h"
+
+#if defined(_WIN32)
+// Keep windows.h from defining min()/max() macros and pulling in the rest of the Win32 headers
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && !defined(IMCANDY_DISABLE_INOTIFY)
+#include <poll.h>
+#include <sys/inotify.h>
+#define IMCANDY_INOTIFY
+#endif
+
+namespace ImCandy
+{
+      /*
+      Theme files, so a palette can be tweaked without rebuilding.
+
+      Text: one entry per line, the name of an ImGuiCol_ color (as in ImGui::GetStyleColorName()) or of a style field,
+      then a hex color (#RRGGBB or #RRGGBBAA) or one/two/four numbers. Lines starting with '#' or ';' are comments,
+      unknown names are skipped so files stay usable across Dear ImGui versions.
+      ---------------------------------------------------------------
+        # Nord
+        WindowBg          #2e3440
+        Border            #4c566a80
+        FrameRounding     3
+        FramePadding      6 4
+      ---------------------------------------------------------------
+
+      Binary: "ICTH", version and entry count (3 x uint32), then 16-byte entries: FNV-1a hash of the name,
+      kind (0 color, 1 float, 2 vec2), RGBA8 color or 1-2 floats. Everything little-endian.
+
+      Both are parsed in place (LoadThemeFile() memory-maps the file) without allocating, on top of the given style.
+      ThemeWatcher copies the file into a buffer instead: an editor may truncate it while it is being read.
+      ---------------------------------------------------------------
+        ImGuiStyle style;
+        if (ImCandy::LoadThemeFile("nord.theme", &style))
+            ImGui::GetStyle() = style;
+
+        // Hot reload: the file is parsed on a background thread, the new style is swapped in at frame start
+        static ImCandy::ThemeWatcher watcher;
+        watcher.Start("nord.theme");
+        ...
+        watcher.ApplyIfChanged(); // before ImGui::NewFrame()
+      ---------------------------------------------------------------
+      */
+
+      namespace detail
+      {
+          enum ThemeEntryKind { ThemeEntry_Color = 0, ThemeEntry_Float = 1, ThemeEntry_Vec2 = 2 };
+
+          inline bool NameEquals(const char* name, const char* s, size_t len) { return strncmp(name, s, len) == 0 && name[len] == '\0'; }
+
+          // FNV-1a over a name that is not null terminated, same values as ThemeRegistry::HashName()
+          inline ImU32 HashName(const char* s, size_t len)
+          {
+              ImU32 hash = 2166136261u;
+              for (size_t i = 0; i < len; i++)
+                  hash = (hash ^ (unsigned char)s[i]) * 16777619u;
+              return hash ? hash : 1;
+          }
+
+          inline ImU32 ReadU32(const unsigned char* p) { return ImU32(p[0]) | (ImU32(p[1]) << 8) | (ImU32(p[2]) << 16) | (ImU32(p[3]) << 24); }
+          inline void WriteU32(ImU32 v, FILE* f) { const unsigned char b[4] = { (unsigned char)v, (unsigned char)(v >> 8), (unsigned char)(v >> 16), (unsigned char)(v >> 24) }; fwrite(b, 1, 4, f); }
+          inline float ReadF32(const unsigned char* p) { const ImU32 v = ReadU32(p); float f; memcpy(&f, &v, 4); return f; }
+          inline void WriteF32(float v, FILE* f) { ImU32 u; memcpy(&u, &v, 4); WriteU32(u, f); }
+
+          inline int HexDigit(char c)
+          {
+              return c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 : c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+          }
+
+          // Decimal number without locale or a terminating '\0', advances p
+          inline bool ParseFloat(const char*& p, const char* end, float* out)
+          {
+              const char* s = p;
+              bool negative = false;
+              if (s < end && (*s == '-' || *s == '+'))
+                  negative = *s++ == '-';
+              double value = 0.0;
+              int digits = 0;
+              for (; s < end && *s >= '0' && *s <= '9'; s++, digits++)
+                  value = value * 10.0 + (*s - '0');
+              if (s < end && *s == '.')
+                  for (double scale = 0.1; ++s < end && *s >= '0' && *s <= '9'; scale *= 0.1, digits++)
+                      value += (*s - '0') * scale;
+              if (digits == 0)
+                  return false;
+              if (s < end && (*s == 'e' || *s == 'E'))
+              {
+                  const char* e = s + 1;
+                  bool negative_exp = false;
+                  if (e < end && (*e == '-' || *e == '+'))
+                      negative_exp = *e++ == '-';
+                  int exponent = 0;
+                  if (e < end && *e >= '0' && *e <= '9')
+                  {
+                      for (; e < end && *e >= '0' && *e <= '9'; e++)
+                          exponent = (std::min)(exponent * 10 + (*e - '0'), 100);
+                      value *= pow(10.0, negative_exp ? -exponent : exponent);
+                      s = e;
+                  }
+              }
+              *out = float(negative ? -value : value);
+              p = s;
+              return true;
+          }
+
+          // #RRGGBB or #RRGGBBAA (also 0x...), advances p
+          inline bool ParseHexColor(const char*& p, const char* end, ImVec4* out)
+          {
+              const char* s = p;
+              if (s < end && *s == '#')
+                  s++;
+              else if (end - s >= 2 && s[0] == '0' && (s[1] == 'x' || s[1] == 'X'))
+                  s += 2;
+              else
+                  return false;
+
+              ImU32 v = 0;
+              int n = 0;
+              for (; s < end && HexDigit(*s) >= 0 && n < 8; s++, n++)
+                  v = (v << 4) | ImU32(HexDigit(*s));
+              if (n == 6)
+                  v = (v << 8) | 0xFF;
+              else if (n != 8)
+                  return false;
+
+              *out = ImVec4(((v >> 24) & 0xFF) / 255.0f, ((v >> 16) & 0xFF) / 255.0f, ((v >> 8) & 0xFF) / 255.0f, (v & 0xFF) / 255.0f);
+              p = s;
+              return true;
+          }
+
+          inline bool ApplyThemeEntry(ImGuiStyle* style, const char* name, size_t len, ImU32 hash, int kind, const float* values)
+          {
+              if (kind == ThemeEntry_Color)
+              {
+                  for (int i = 0; i < ImGuiCol_COUNT; i++)
+                      if (name ? NameEquals(ImGui::GetStyleColorName(i), name, len) : ThemeRegistry::HashName(ImGui::GetStyleColorName(i)) == hash)
+                      {
+                          style->Colors[i] = ImVec4(values[0], values[1], values[2], values[3]);
+                          return true;
+                      }
+              }
+              else if (kind == ThemeEntry_Float)
+              {
+                  int count = 0;
+                  const StyleFloatField* fields = StyleFloatFields(&count);
+                  for (int i = 0; i < count; i++)
+                      if (name ? NameEquals(fields[i].Name, name, len) : ThemeRegistry::HashName(fields[i].Name) == hash)
+                      {
+                          style->*(fields[i].Field) = values[0];
+                          return true;
+                      }
+              }
+              else
+              {
+                  int count = 0;
+                  const StyleVec2Field* fields = StyleVec2Fields(&count);
+                  for (int i = 0; i < count; i++)
+                      if (name ? NameEquals(fields[i].Name, name, len) : ThemeRegistry::HashName(fields[i].Name) == hash)
+                      {
+                          style->*(fields[i].Field) = ImVec2(values[0], values[1]);
+                          return true;
+                      }
+              }
+              return false;
+          }
+
+          inline bool ParseThemeBinary(const unsigned char* data, size_t size, ImGuiStyle* style)
+          {
+              if (size < 12 || ReadU32(data + 4) != 1)
+                  return false;
+              const ImU32 count = ReadU32(data + 8);
+              if ((size - 12) / 16 < count)
+                  return false;
+
+              for (const unsigned char* e = data + 12; e < data + 12 + size_t(count) * 16; e += 16)
+              {
+                  const ImU32 hash = ReadU32(e);
+                  const int kind = int(ReadU32(e + 4));
+                  if (kind > ThemeEntry_Vec2)
+                      continue;
+                  float values[4];
+                  if (kind == ThemeEntry_Color)
+                      for (int c = 0; c < 4; c++)
+                          values[c] = e[8 + c] / 255.0f;
+                  else
+                  {
+                      values[0] = ReadF32(e + 8);
+                      values[1] = ReadF32(e + 12);
+                  }
+                  ApplyThemeEntry(style, NULL, 0, hash, kind, values);
+              }
+              return true;
+          }
+
+          inline bool ParseThemeText(const char* p, const char* end, ImGuiStyle* style, int* error_line)
+          {
+              for (int line = 1; p < end; line++)
+              {
+                  const char* eol = p;
+                  while (eol < end && *eol != '\n')
+                      eol++;
+                  const char* next = eol < end ? eol + 1 : eol;
+                  while (eol > p && (eol[-1] == '\r' || eol[-1] == ' ' || eol[-1] == '\t'))
+                      eol--;
+                  while (p < eol && (*p == ' ' || *p == '\t'))
+                      p++;
+
+                  if (p < eol && *p != '#' && *p != ';')
+                  {
+                      const char* name = p;
+                      while (p < eol && (isalnum((unsigned char)*p) || *p == '_'))
+                          p++;
+                      const size_t len = size_t(p - name);
+
+                      float values[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+                      int count = 0;
+                      ImVec4 color;
+                      while (p < eol && (*p == ' ' || *p == '\t' || *p == ':' || *p == '='))
+                          p++;
+                      if (ParseHexColor(p, eol, &color))
+                      {
+                          values[0] = color.x; values[1] = color.y; values[2] = color.z; values[3] = color.w;
+                          count = 4;
+                      }
+                      else
+                      {
+                          while (count < 4 && ParseFloat(p, eol, &values[count]))
+                          {
+                              count++;
+                              while (p < eol && (*p == ' ' || *p == '\t' || *p == ','))
+                                  p++;
+                          }
+                          if (count == 3)
+                              values[3] = 1.0f;
+                      }
+
+                      if (len == 0 || count == 0 || p != eol)
+                      {
+                          if (error_line)
+                              *error_line = line;
+                          return false;
+                      }
+
+                      const int kind = count >= 3 ? ThemeEntry_Color : count == 2 ? ThemeEntry_Vec2 : ThemeEntry_Float;
+                      ApplyThemeEntry(style, name, len, 0, kind, values);
+                  }
+                  p = next;
+              }
+              return true;
+          }
+
+          // Read-only mapping of a whole file
+          class MappedFile
+          {
+          public:
+              explicit MappedFile(const char* path)
+              {
+#if defined(_WIN32)
+                  File = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+                  LARGE_INTEGER size;
+                  if (File == INVALID_HANDLE_VALUE || !GetFileSizeEx(File, &size))
+                      return;
+                  Size = size_t(size.QuadPart);
+                  Valid = true;
+                  if (Size == 0)
+                      return;
+                  Mapping = CreateFileMappingA(File, NULL, PAGE_READONLY, 0, 0, NULL);
+                  Data = Mapping ? (const char*)MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+                  Valid = Data != NULL;
+#else
+                  const int fd = open(path, O_RDONLY);
+                  struct stat st;
+                  if (fd < 0)
+                      return;
+                  if (fstat(fd, &st) == 0)
+                  {
+                      Size = size_t(st.st_size);
+                      Valid = true;
+                      if (Size > 0)
+                      {
+                          void* data = mmap(NULL, Size, PROT_READ, MAP_PRIVATE, fd, 0);
+                          Data = data != MAP_FAILED ? (const char*)data : NULL;
+                          Valid = Data != NULL;
+                      }
+                  }
+                  close(fd);
+#endif
+              }
+
+              ~MappedFile()
+              {
+#if defined(_WIN32)
+                  if (Data) UnmapViewOfFile(Data);
+                  if (Mapping) CloseHandle(Mapping);
+                  if (File != INVALID_HANDLE_VALUE) CloseHandle(File);
+#else
+                  if (Data) munmap((void*)Data, Size);
+#endif
+              }
+
+              MappedFile(const MappedFile&) = delete;
+              MappedFile& operator=(const MappedFile&) = delete;
+
+              const char* Data = NULL;
+              size_t Size = 0;
+              bool Valid = false;
+
+#if defined(_WIN32)
+          private:
+              HANDLE File = INVALID_HANDLE_VALUE;
+              HANDLE Mapping = NULL;
+#endif
+          };
+
+          // Copies a whole file into buffer, false when it cannot be read or holds more than 'capacity' bytes.
+          // Unlike a mapping, a file truncated meanwhile only gives a short read.
+          inline bool ReadFileInto(const char* path, char* buffer, size_t capacity, size_t* size)
+          {
+              FILE* f = fopen(path, "rb");
+              if (!f)
+                  return false;
+              *size = fread(buffer, 1, capacity, f);
+              const bool complete = !ferror(f) && (*size < capacity || fgetc(f) == EOF);
+              fclose(f);
+              return complete;
+          }
+      }
+
+      // Applies a text or binary theme (detected from the "ICTH" magic) on top of *dst.
+      // On a syntax error *dst may be partially updated, parse into a copy to keep it intact.
+      inline bool ParseTheme(const char* data, size_t size, ImGuiStyle* dst, int* error_line = NULL)
+      {
+          IMCANDY_METRICS_SCOPE(ThemeFile, size);
+          if (size >= 4 && memcmp(data, "ICTH", 4) == 0)
+              return detail::ParseThemeBinary((const unsigned char*)data, size, dst);
+          return detail::ParseThemeText(data, data + size, dst, error_line);
+      }
+
+      inline bool LoadThemeFile(const char* path, ImGuiStyle* dst, int* error_line = NULL)
+      {
+          detail::MappedFile file(path);
+          return file.Valid && ParseTheme(file.Data, file.Size, dst, error_line);
+      }
+
+      // Writes every color and style field the format knows
+      inline bool SaveThemeFile(const char* path, const ImGuiStyle& style, bool binary = false)
+      {
+          FILE* f = fopen(path, binary ? "wb" : "w");
+          if (!f)
+              return false;
+
+          int float_count = 0, vec2_count = 0;
+          const detail::StyleFloatField* floats = detail::StyleFloatFields(&float_count);
+          const detail::StyleVec2Field* vec2s = detail::StyleVec2Fields(&vec2_count);
+          if (binary)
+          {
+              fwrite("ICTH", 1, 4, f);
+              detail::WriteU32(1, f);
+              detail::WriteU32(ImU32(ImGuiCol_COUNT + float_count + vec2_count), f);
+          }
+
+          for (int i = 0; i < ImGuiCol_COUNT; i++)
+          {
+              const ImVec4& c = style.Colors[i];
+              const ImU32 col = detail::PackColor(c);
+              const unsigned int r = (col >> IM_COL32_R_SHIFT) & 0xFF, g = (col >> IM_COL32_G_SHIFT) & 0xFF, b = (col >> IM_COL32_B_SHIFT) & 0xFF, a = (col >> IM_COL32_A_SHIFT) & 0xFF;
+              if (binary)
+              {
+                  detail::WriteU32(ThemeRegistry::HashName(ImGui::GetStyleColorName(i)), f);
+                  detail::WriteU32(detail::ThemeEntry_Color, f);
+                  detail::WriteU32(r | (g << 8) | (b << 16) | (a << 24), f);
+                  detail::WriteU32(0, f);
+              }
+              else
+                  fprintf(f, "%-24s #%02x%02x%02x%02x\n", ImGui::GetStyleColorName(i), r, g, b, a);
+          }
+          for (int i = 0; i < float_count; i++)
+          {
+              const float v = style.*(floats[i].Field);
+              if (binary)
+              {
+                  detail::WriteU32(ThemeRegistry::HashName(floats[i].Name), f);
+                  detail::WriteU32(detail::ThemeEntry_Float, f);
+                  detail::WriteF32(v, f);
+                  detail::WriteF32(0.0f, f);
+              }
+              else
+                  fprintf(f, "%-24s %g\n", floats[i].Name, v);
+          }
+          for (int i = 0; i < vec2_count; i++)
+          {
+              const ImVec2 v = style.*(vec2s[i].Field);
+              if (binary)
+              {
+                  detail::WriteU32(ThemeRegistry::HashName(vec2s[i].Name), f);
+                  detail::WriteU32(detail::ThemeEntry_Vec2, f);
+                  detail::WriteF32(v.x, f);
+                  detail::WriteF32(v.y, f);
+              }
+              else
+                  fprintf(f, "%-24s %g %g\n", vec2s[i].Name, v.x, v.y);
+          }
+          return fclose(f) == 0;
+      }
+
+      // Reloads a theme file when it changes: inotify on Linux, polling of the modification time elsewhere
+      // (or with IMCANDY_DISABLE_INOTIFY). Parsing happens on a background thread, ApplyIfChanged() copies
+      // the finished style in and never waits for the parser.
+      class ThemeWatcher
+      {
+      public:
+          // Larger files are not loaded, set before Start(). A full text theme is a few KB.
+          size_t MaxFileSize = 256 * 1024;
+
+          ThemeWatcher() {}
+          ~ThemeWatcher() { Stop(); }
+
+          ThemeWatcher(const ThemeWatcher&) = delete;
+          ThemeWatcher& operator=(const ThemeWatcher&) = delete;
+
+          // The file is applied over 'base' (ImGuiStyle() when NULL) and loaded once right away, returns whether
+          // that first load succeeded (see GetErrorLine()). The file is watched either way, so it may appear later.
+          bool Start(const char* path, const ImGuiStyle* base = NULL, float poll_interval = 0.5f)
+          {
+              Stop();
+              Path = path;
+              Base = base ? *base : ImGuiStyle();
+              PollInterval = poll_interval;
+              Buffer.resize(MaxFileSize);
+              Stopping = false;
+              const bool loaded = Reload();
+              Worker = std::thread([this] { Watch(); });
+              return loaded;
+          }
+
+          void Stop()
+          {
+              Stopping = true;
+              if (Worker.joinable())
+                  Worker.join();
+          }
+
+          // Call at frame start, e.g. before ImGui::NewFrame(). Returns true when a new style was applied.
+          bool ApplyIfChanged(ImGuiStyle* dst = NULL)
+          {
+              if (!HasPending.load(std::memory_order_acquire))
+                  return false;
+              std::lock_guard<std::mutex> lock(Mutex);
+              *(dst ? dst : &ImGui::GetStyle()) = Pending;
+              HasPending.store(false, std::memory_order_relaxed);
+              return true;
+          }
+
+          // Result of the last load: 0 when it succeeded, the line of the syntax error, or -1 when the file could
+          // not be read (missing, unreadable, larger than MaxFileSize) or is a malformed binary theme
+          int GetErrorLine() const { return ErrorLine.load(); }
+
+      private:
+          bool Reload()
+          {
+              ImGuiStyle style = Base;
+              size_t size = 0;
+              int error_line = -1;
+              if (!detail::ReadFileInto(Path.c_str(), Buffer.data(), Buffer.size(), &size) || !ParseTheme(Buffer.data(), size, &style, &error_line))
+              {
+                  ErrorLine = error_line;
+                  return false;
+              }
+              ErrorLine = 0;
+              std::lock_guard<std::mutex> lock(Mutex);
+              Pending = style;
+              HasPending.store(true, std::memory_order_release);
+              return true;
+          }
+
+          void Watch()
+          {
+#if defined(IMCANDY_INOTIFY)
+              if (WatchInotify())
+                  return;
+#endif
+              WatchPolling();
+          }
+
+          void WatchPolling()
+          {
+              struct stat st;
+              const bool exists = stat(Path.c_str(), &st) == 0;
+              time_t last_time = exists ? st.st_mtime : 0;
+              off_t last_size = exists ? st.st_size : 0;
+              ino_t last_inode = exists ? st.st_ino : 0;
+              for (float waited = 0.0f; !Stopping; )
+              {
+                  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                  if ((waited += 0.05f) < PollInterval)
+                      continue;
+                  waited = 0.0f;
+                  // Modification time (1 s resolution), size and inode, the latter catches saves by rename
+                  if (stat(Path.c_str(), &st) == 0 && (st.st_mtime != last_time || st.st_size != last_size || st.st_ino != last_inode))
+                  {
+                      last_time = st.st_mtime;
+                      last_size = st.st_size;
+                      last_inode = st.st_ino;
+                      Reload();
+                  }
+              }
+          }
+
+#if defined(IMCANDY_INOTIFY)
+          // Watches the directory, editors often save by renaming a new file over the old one
+          bool WatchInotify()
+          {
+              const size_t slash = Path.find_last_of('/');
+              const std::string dir = slash == std::string::npos ? "." : Path.substr(0, slash + 1);
+              const std::string file = slash == std::string::npos ? Path : Path.substr(slash + 1);
+
+              const int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+              if (fd < 0)
+                  return false;
+              if (inotify_add_watch(fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+              {
+                  close(fd);
+                  return false;
+              }
+
+              alignas(struct inotify_event) char buffer[4096];
+              while (!Stopping)
+              {
+                  struct pollfd pfd = { fd, POLLIN, 0 };
+                  if (poll(&pfd, 1, 100) <= 0)
+                      continue;
+
+                  bool changed = false;
+                  ssize_t len;
+                  while ((len = read(fd, buffer, sizeof(buffer))) > 0)
+                      for (char* p = buffer; p < buffer + len; )
+                      {
+                          const struct inotify_event* event = (const struct inotify_event*)p;
+                          if (event->len > 0 && file == event->name)
+                              changed = true;
+                          p += sizeof(struct inotify_event) + event->len;
+                      }
+                  if (changed)
+                      Reload();
+              }
+              close(fd);
+              return true;
+          }
+#endif
+
+          std::string Path;
+          std::vector<char> Buffer;     // Watcher thread only, MaxFileSize bytes
+          ImGuiStyle Base;
+          ImGuiStyle Pending;
+          float PollInterval = 0.5f;
+          std::thread Worker;
+          std::mutex Mutex;
+          std::atomic<bool> HasPending{false};
+          std::atomic<bool> Stopping{false};
+          std::atomic<int> ErrorLine{0};
+      };
+};
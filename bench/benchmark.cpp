@@ -0,0 +1,217 @@
+// Headless benchmark of the hot paths, built against the imgui.h stand-in in tests/:
+// prints the time per evaluated color (or per call) of each case, best of a few runs, the matching
+// throughput and the heap allocations per call.
+//   imcandy_benchmark [filter]    runs the cases whose name contains 'filter'
+#include <stdint.h>
+#include <stdlib.h>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <string>
+#include <vector>
+#include "candy.h"
+#include "parallel.h"
+
+using namespace gradient;
+
+static const char* Filter = NULL;
+static volatile uint32_t Sink = 0;
+
+// Every heap allocation of the process goes through here, worker threads included.
+// Not inlined: GCC would then pair the std::allocator calls with malloc/free and warn about a mismatch.
+#if defined(__GNUC__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE
+#endif
+
+static std::atomic<uint64_t> Allocations(0);
+
+BENCH_NOINLINE void* operator new(size_t size)
+{
+    Allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+BENCH_NOINLINE void operator delete(void* p) noexcept
+{
+    free(p);
+}
+
+BENCH_NOINLINE void operator delete(void* p, size_t) noexcept
+{
+    free(p);
+}
+
+// Runs fn until it has taken ~50 ms, five times, and reports the fastest run per item, the items per
+// second it amounts to and the allocations per call (fewest of the runs)
+template<typename Fn>
+static void Run(const char* name, size_t items_per_call, Fn fn)
+{
+    if (Filter && !strstr(name, Filter))
+        return;
+    typedef std::chrono::steady_clock Clock;
+    fn();
+    double best = 1e300, allocs = 1e300;
+    for (int run = 0; run < 5; run++)
+    {
+        int calls = 0;
+        const uint64_t allocs_before = Allocations.load(std::memory_order_relaxed);
+        const Clock::time_point start = Clock::now();
+        double elapsed = 0.0;
+        do
+        {
+            fn();
+            calls++;
+            elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        } while (elapsed < 50e6);
+        best = std::min(best, elapsed / (double(calls) * double(items_per_call)));
+        allocs = std::min(allocs, double(Allocations.load(std::memory_order_relaxed) - allocs_before) / calls);
+    }
+    printf("%-40s %10.2f ns %10.2f M/s %8.2f allocs/call\n", name, best, 1e3 / best, allocs);
+}
+
+template<typename G>
+static void Fill(G& g, int stops)
+{
+    for (int i = 0; i < stops; i++)
+    {
+        const float k = float(i) / float(stops - 1);
+        g[k] = Color4{ k, 1.0f - k, fmodf(k * 7.0f, 1.0f), 1.0f };
+    }
+}
+
+static void BenchGradients(int stops)
+{
+    const size_t count = 4096;
+    std::vector<float> points(count), rgba(4 * count);
+    std::vector<uint32_t> packed(count);
+    for (size_t i = 0; i < count; i++)
+        points[i] = float(i) / float(count - 1);
+
+    LinearColor4Gradient linear;
+    FlatLinearColor4Gradient flat;
+    Fill(linear, stops);
+    Fill(flat, stops);
+    const GradientSnapshot<float> snapshot(linear);
+    BatchScratch<float> scratch;
+
+    char name[64];
+    snprintf(name, sizeof(name), "linear %d stops, operator()", stops);
+    Run(name, count, [&] { for (size_t i = 0; i < count; i++) Sink += uint32_t(linear(points[i]).r * 255.0f); });
+    snprintf(name, sizeof(name), "linear %d stops, evaluate packed", stops);
+    Run(name, count, [&] { linear.evaluate(points.data(), count, packed.data()); Sink += packed[7]; });
+    snprintf(name, sizeof(name), "linear %d stops, evaluate + scratch", stops);
+    Run(name, count, [&] { linear.evaluate(points.data(), count, packed.data(), scratch); Sink += packed[7]; });
+    snprintf(name, sizeof(name), "flat %d stops, operator()", stops);
+    Run(name, count, [&] { for (size_t i = 0; i < count; i++) Sink += uint32_t(flat(points[i]).r * 255.0f); });
+    snprintf(name, sizeof(name), "flat %d stops, evaluate float", stops);
+    Run(name, count, [&] { flat.evaluate(points.data(), count, rgba.data()); Sink += uint32_t(rgba[7]); });
+    snprintf(name, sizeof(name), "flat %d stops, evaluate packed", stops);
+    Run(name, count, [&] { flat.evaluate(points.data(), count, packed.data()); Sink += packed[7]; });
+    snprintf(name, sizeof(name), "snapshot %d stops, evaluate packed", stops);
+    Run(name, count, [&] { snapshot.evaluate(points.data(), count, packed.data()); Sink += packed[7]; });
+}
+
+static void BenchTables()
+{
+    const size_t count = 4096;
+    std::vector<float> points(count), field(count);
+    std::vector<uint32_t> packed(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        points[i] = float((i * 2654435761u) % count) / float(count - 1);
+        field[i] = points[i] * 100.0f;
+    }
+
+    FlatLinearColor4Gradient flat;
+    Fill(flat, 8);
+    const BakedGradient<float> baked(flat, 1024);
+    Run("baked nearest", count, [&] { baked.sample(points.data(), count, packed.data(), false); Sink += packed[7]; });
+    Run("baked lerp", count, [&] { baked.sample(points.data(), count, packed.data(), true); Sink += packed[7]; });
+    Run("bake 1024 entries", 1, [&] { BakedGradient<float> b(flat, 1024); Sink += b.data()[3]; });
+
+    ImCandy::Colormap map(flat);
+    map.SetRange(0.0f, 100.0f);
+    Run("colormap float field", count, [&] { map.Map(field.data(), count, packed.data()); Sink += packed[7]; });
+    Run("colormap rebake", 1, [&] { ImCandy::Colormap m(flat); Sink += m.GetTable()[3]; });
+
+    double ratio = 0.0;
+    Run("Rainbow()", 1, [&] { Sink += uint32_t(ImCandy::Rainbow(ratio).x * 255.0f); });
+    Run("RainbowP()", 1, [&] { Sink += uint32_t(ImCandy::RainbowP(0.001).x * 255.0f); });
+    Run("RainbowU32()", 1, [&] { Sink += ImCandy::RainbowU32(ratio); });
+    Run("Gradient2()", 1, [&] { Sink += uint32_t(ImCandy::Gradient2(ImVec4(1, 0, 0, 1), ImVec4(0, 0, 1, 1), ratio, 0.001).x * 255.0f); });
+    Run("Gradient2() OKLab", 1, [&] { Sink += uint32_t(ImCandy::Gradient2(ImVec4(1, 0, 0, 1), ImVec4(0, 0, 1, 1), ratio, 0.001, ColorSpace::OKLab).x * 255.0f); });
+}
+
+static void BenchHsv()
+{
+    const size_t count = 1 << 16;
+    std::vector<uint32_t> packed(count), out(count);
+    std::vector<HSV8> hsv(count);
+    std::vector<float> rgba(4 * count), rgba_out(4 * count);
+    for (size_t i = 0; i < count; i++)
+    {
+        packed[i] = uint32_t(i * 2654435761u);
+        for (int c = 0; c < 4; c++)
+            rgba[4 * i + c] = ((packed[i] >> (8 * c)) & 0xFF) / 255.0f;
+    }
+    rgba8_to_hsv8(packed.data(), count, hsv.data());
+
+    Run("rgba8_to_hsv8", count, [&] { rgba8_to_hsv8(packed.data(), count, hsv.data()); Sink += hsv[7].h; });
+    Run("hsv8_to_rgba8", count, [&] { hsv8_to_rgba8(hsv.data(), count, out.data()); Sink += out[7]; });
+    Run("adjust_hsl packed", count, [&] { adjust_hsl(packed.data(), count, 0.1f, 1.2f, 0.05f, out.data()); Sink += out[7]; });
+    Run("adjust_hsl float", count, [&] { adjust_hsl(rgba.data(), count, 0.1f, 1.2f, 0.05f, rgba_out.data()); Sink += uint32_t(rgba_out[7]); });
+}
+
+static void BenchDrawing()
+{
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    FlatLinearColor4Gradient flat;
+    LinearColor4Gradient linear;
+    Fill(flat, 8);
+    Fill(linear, 40);
+    const ImCandy::Gradient<3> fixed = {{ ImVec4(1, 0, 0, 1), ImVec4(0, 1, 0, 1), ImVec4(0, 0, 1, 1) }};
+
+    // Per call, the draw list is rewound so it does not grow
+    Run("DrawGradientRect Gradient<3>", 1, [&] { ImCandy::DrawGradientRect(draw_list, ImVec2(0, 0), ImVec2(100, 20), fixed); draw_list->PrimUnreserve(draw_list->IdxBuffer.Size, draw_list->VtxBuffer.Size); draw_list->_VtxCurrentIdx = 0; });
+    Run("DrawGradientRect flat 8 stops", 1, [&] { ImCandy::DrawGradientRect(draw_list, ImVec2(0, 0), ImVec2(100, 20), flat); draw_list->PrimUnreserve(draw_list->IdxBuffer.Size, draw_list->VtxBuffer.Size); draw_list->_VtxCurrentIdx = 0; });
+    Run("DrawGradientBorder linear 40 stops", 1, [&] { ImCandy::DrawGradientBorder(draw_list, ImVec2(0, 0), ImVec2(100, 20), linear, 2.0f); draw_list->PrimUnreserve(draw_list->IdxBuffer.Size, draw_list->VtxBuffer.Size); draw_list->_VtxCurrentIdx = 0; });
+
+    ImCandy::StyleBindings bindings;
+    for (int i = 0; i < ImGuiCol_COUNT; i++)
+        bindings.Bind(i, ImCandy::RainbowGradient(), 0.5f, float(i) / ImGuiCol_COUNT);
+    ImGuiStyle style;
+    Run("StyleBindings update, all colors", ImGuiCol_COUNT, [&] { StubNewFrame(1.0f / 60.0f); bindings.Update(); bindings.Apply(&style); });
+}
+
+static void BenchParallel()
+{
+    const size_t count = 1 << 20;
+    std::vector<float> points(count);
+    std::vector<ImU32> out(count);
+    for (size_t i = 0; i < count; i++)
+        points[i] = float(i) / float(count - 1);
+    FlatLinearColor4Gradient flat;
+    Fill(flat, 8);
+    const GradientSnapshot<float> snapshot(flat);
+
+    static ImCandy::ThreadPool pool;
+    char name[64];
+    snprintf(name, sizeof(name), "ColorizeParallel, %u threads", pool.GetThreadCount());
+    Run(name, count, [&] { ImCandy::ColorizeParallel(pool, snapshot, points.data(), count, out.data()); Sink += out[7]; });
+}
+
+int main(int argc, char** argv)
+{
+    Filter = argc > 1 ? argv[1] : NULL;
+    BenchGradients(4);
+    BenchGradients(40);
+    BenchTables();
+    BenchHsv();
+    BenchDrawing();
+    BenchParallel();
+    return 0;
+}
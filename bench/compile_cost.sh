@@ -0,0 +1,75 @@
+#!/bin/sh
+# Compile time and code size of the default inline build vs IMCANDY_SEPARATE_IMPLEMENTATION.
+# Builds an app of N translation units that each include candy.h, themefile.h and parallel.h
+# and use a few functions, at -O0 and -O2, and prints the compile time, the total size of the
+# objects and the size of the linked binary.
+#   bench/compile_cost.sh [units=8]     (CXX, CXXFLAGS and LDFLAGS are honoured)
+set -e
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+CXX=${CXX:-c++}
+UNITS=${1:-8}
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+i=0
+while [ $i -lt "$UNITS" ]; do
+    cat > "$WORK/unit$i.cpp" <<SRC
+#include "candy.h"
+#include "parallel.h"
+#include "themefile.h"
+ImU32 Unit$i(ImDrawList* draw, float t)
+{
+    static gradient::LinearColor4Gradient gradient;
+    gradient[0.0f] = gradient::Color4{ 1.0f, 0.0f, 0.0f, 1.0f };
+    gradient[1.0f] = gradient::Color4{ 0.0f, 0.0f, 1.0f, 1.0f };
+    ImCandy::DrawGradientBorder(draw, ImVec2(0, 0), ImVec2(64, 64), gradient, t);
+    ImCandy::Theme_Nord();
+    ImCandy::ParseTheme("WindowBg = #202020", 18, &ImGui::GetStyle());
+    static double ratio = 0.0;
+    return ImGui::ColorConvertFloat4ToU32(ImCandy::Rainbow(ratio, t));
+}
+SRC
+    i=$((i + 1))
+done
+{
+    i=0
+    while [ $i -lt "$UNITS" ]; do echo "ImU32 Unit$i(ImDrawList*, float);"; i=$((i + 1)); done
+    echo "int main() { ImU32 sum = 0;"
+    i=0
+    while [ $i -lt "$UNITS" ]; do echo "    sum += Unit$i(ImGui::GetWindowDrawList(), 0.5f);"; i=$((i + 1)); done
+    echo "    return (int)(sum & 1); }"
+} > "$WORK/main.cpp"
+printf '#include "imgui.h"\n' | cat - "$WORK/main.cpp" > "$WORK/main2.cpp" && mv "$WORK/main2.cpp" "$WORK/main.cpp"
+printf '#define IMCANDY_IMPLEMENTATION\n#include "candy.h"\n#include "parallel.h"\n#include "themefile.h"\n' > "$WORK/impl.cpp"
+
+CXXFLAGS_COMMON="$CXXFLAGS -std=c++11 -I$ROOT/ImCandy -I$ROOT/tests"
+"$CXX" $CXXFLAGS_COMMON -O2 -c "$ROOT/tests/imgui_stub.cpp" -o "$WORK/imgui_stub.o"
+
+now() { date +%s.%N; }
+bytes() { wc -c < "$1" | tr -d ' '; }
+
+printf '%-6s %-9s %10s %12s %12s\n' "flags" "build" "compile s" "objects KiB" "binary KiB"
+for opt in -O0 -O2; do
+    for mode in inline separate; do
+        defs=""
+        sources=""
+        i=0
+        while [ $i -lt "$UNITS" ]; do sources="$sources unit$i"; i=$((i + 1)); done
+        if [ $mode = separate ]; then
+            defs="-DIMCANDY_SEPARATE_IMPLEMENTATION"
+            sources="$sources impl"
+        fi
+        rm -f "$WORK"/*.obj
+        start=$(now)
+        for s in $sources main; do
+            "$CXX" $CXXFLAGS_COMMON $opt $defs -c "$WORK/$s.cpp" -o "$WORK/$s.obj"
+        done
+        end=$(now)
+        objects=0
+        for s in $sources main; do objects=$((objects + $(bytes "$WORK/$s.obj"))); done
+        "$CXX" $opt "$WORK"/*.obj "$WORK/imgui_stub.o" -o "$WORK/app" -pthread $LDFLAGS
+        strip "$WORK/app" 2>/dev/null || true
+        printf '%-6s %-9s %10.2f %12d %12d\n' "$opt" "$mode" "$(awk "BEGIN { print $end - $start }")" \
+            $((objects / 1024)) $(($(bytes "$WORK/app") / 1024))
+    done
+done
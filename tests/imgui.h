@@ -0,0 +1,276 @@
+// Minimal stand-in for Dear ImGui 1.85 so the tests and benchmarks build without it.
+// Only the declarations ImCandy uses are here; imgui_stub.cpp implements them with a fake clock and no rendering.
+#pragma once
+
+#include <float.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define IMGUI_VERSION "1.85"
+#define IMGUI_VERSION_NUM 18500
+
+typedef unsigned int   ImU32;
+typedef unsigned short ImU16;
+typedef unsigned char  ImU8;
+typedef unsigned int   ImGuiID;
+typedef unsigned short ImDrawIdx;
+typedef void*          ImTextureID;
+typedef int            ImGuiCol;
+typedef int            ImGuiDir;
+typedef int            ImGuiStyleVar;
+typedef int            ImGuiWindowFlags;
+typedef int            ImGuiColorEditFlags;
+typedef int            ImGuiButtonFlags;
+typedef int            ImGuiMouseButton;
+
+struct ImGuiContext;
+
+struct ImVec2
+{
+    float x, y;
+    constexpr ImVec2() : x(0.0f), y(0.0f) {}
+    constexpr ImVec2(float _x, float _y) : x(_x), y(_y) {}
+};
+
+struct ImVec4
+{
+    float x, y, z, w;
+    constexpr ImVec4() : x(0.0f), y(0.0f), z(0.0f), w(0.0f) {}
+    constexpr ImVec4(float _x, float _y, float _z, float _w) : x(_x), y(_y), z(_z), w(_w) {}
+};
+
+#define IM_COL32_R_SHIFT    0
+#define IM_COL32_G_SHIFT    8
+#define IM_COL32_B_SHIFT    16
+#define IM_COL32_A_SHIFT    24
+#define IM_COL32_A_MASK     0xFF000000
+#define IM_COL32(R,G,B,A)   (((ImU32)(A)<<IM_COL32_A_SHIFT) | ((ImU32)(B)<<IM_COL32_B_SHIFT) | ((ImU32)(G)<<IM_COL32_G_SHIFT) | ((ImU32)(R)<<IM_COL32_R_SHIFT))
+#define IM_COL32_WHITE      IM_COL32(255,255,255,255)
+#define IM_ASSERT(_EXPR)    ((void)(_EXPR))
+#define IM_ARRAYSIZE(_ARR)  ((int)(sizeof(_ARR) / sizeof(*(_ARR))))
+
+enum ImGuiCol_
+{
+    ImGuiCol_Text, ImGuiCol_TextDisabled, ImGuiCol_WindowBg, ImGuiCol_ChildBg, ImGuiCol_PopupBg, ImGuiCol_Border,
+    ImGuiCol_BorderShadow, ImGuiCol_FrameBg, ImGuiCol_FrameBgHovered, ImGuiCol_FrameBgActive, ImGuiCol_TitleBg,
+    ImGuiCol_TitleBgActive, ImGuiCol_TitleBgCollapsed, ImGuiCol_MenuBarBg, ImGuiCol_ScrollbarBg, ImGuiCol_ScrollbarGrab,
+    ImGuiCol_ScrollbarGrabHovered, ImGuiCol_ScrollbarGrabActive, ImGuiCol_CheckMark, ImGuiCol_SliderGrab,
+    ImGuiCol_SliderGrabActive, ImGuiCol_Button, ImGuiCol_ButtonHovered, ImGuiCol_ButtonActive, ImGuiCol_Header,
+    ImGuiCol_HeaderHovered, ImGuiCol_HeaderActive, ImGuiCol_Separator, ImGuiCol_SeparatorHovered, ImGuiCol_SeparatorActive,
+    ImGuiCol_ResizeGrip, ImGuiCol_ResizeGripHovered, ImGuiCol_ResizeGripActive, ImGuiCol_Tab, ImGuiCol_TabHovered,
+    ImGuiCol_TabActive, ImGuiCol_TabUnfocused, ImGuiCol_TabUnfocusedActive, ImGuiCol_PlotLines, ImGuiCol_PlotLinesHovered,
+    ImGuiCol_PlotHistogram, ImGuiCol_PlotHistogramHovered, ImGuiCol_TableHeaderBg, ImGuiCol_TableBorderStrong,
+    ImGuiCol_TableBorderLight, ImGuiCol_TableRowBg, ImGuiCol_TableRowBgAlt, ImGuiCol_TextSelectedBg, ImGuiCol_DragDropTarget,
+    ImGuiCol_NavHighlight, ImGuiCol_NavWindowingHighlight, ImGuiCol_NavWindowingDimBg, ImGuiCol_ModalWindowDimBg,
+    ImGuiCol_COUNT
+};
+
+enum { ImGuiMouseButton_Left = 0, ImGuiMouseButton_Right = 1 };
+enum { ImGuiColorEditFlags_None = 0, ImGuiColorEditFlags_NoInputs = 1 << 5, ImGuiColorEditFlags_NoLabel = 1 << 7, ImGuiColorEditFlags_AlphaBar = 1 << 16 };
+enum { ImGuiMouseCursor_ResizeEW = 4 };
+enum { ImGuiWindowFlags_None = 0 };
+enum ImGuiTableFlags_ { ImGuiTableFlags_RowBg = 1 << 6, ImGuiTableFlags_Borders = 0x780 };
+
+struct ImGuiStyle
+{
+    float       Alpha;
+    float       DisabledAlpha;
+    ImVec2      WindowPadding;
+    float       WindowRounding;
+    float       WindowBorderSize;
+    ImVec2      WindowMinSize;
+    ImVec2      WindowTitleAlign;
+    ImGuiDir    WindowMenuButtonPosition;
+    float       ChildRounding;
+    float       ChildBorderSize;
+    float       PopupRounding;
+    float       PopupBorderSize;
+    ImVec2      FramePadding;
+    float       FrameRounding;
+    float       FrameBorderSize;
+    ImVec2      ItemSpacing;
+    ImVec2      ItemInnerSpacing;
+    ImVec2      CellPadding;
+    ImVec2      TouchExtraPadding;
+    float       IndentSpacing;
+    float       ColumnsMinSpacing;
+    float       ScrollbarSize;
+    float       ScrollbarRounding;
+    float       GrabMinSize;
+    float       GrabRounding;
+    float       LogSliderDeadzone;
+    float       TabRounding;
+    float       TabBorderSize;
+    float       TabMinWidthForCloseButton;
+    ImGuiDir    ColorButtonPosition;
+    ImVec2      ButtonTextAlign;
+    ImVec2      SelectableTextAlign;
+    ImVec2      DisplayWindowPadding;
+    ImVec2      DisplaySafeAreaPadding;
+    float       MouseCursorScale;
+    bool        AntiAliasedLines;
+    bool        AntiAliasedLinesUseTex;
+    bool        AntiAliasedFill;
+    float       CurveTessellationTol;
+    float       CircleTessellationMaxError;
+    ImVec4      Colors[ImGuiCol_COUNT];
+
+    ImGuiStyle();
+};
+
+struct ImGuiIO
+{
+    float       DeltaTime = 1.0f / 60.0f;
+    float       Framerate = 60.0f;
+    ImVec2      MousePos;
+    bool        MouseDown[5];
+    bool        KeyCtrl;
+};
+
+// Same layout and semantics as Dear ImGui's: elements are moved with memcpy, never constructed
+template<typename T>
+struct ImVector
+{
+    int         Size = 0;
+    int         Capacity = 0;
+    T*          Data = NULL;
+
+    ImVector() {}
+    ImVector(const ImVector<T>& src) { operator=(src); }
+    ImVector<T>& operator=(const ImVector<T>& src) { clear(); resize(src.Size); if (src.Data) memcpy(Data, src.Data, (size_t)Size * sizeof(T)); return *this; }
+    ~ImVector() { free(Data); }
+
+    bool        empty() const { return Size == 0; }
+    int         size() const { return Size; }
+    int         size_in_bytes() const { return Size * (int)sizeof(T); }
+    T&          operator[](int i) { return Data[i]; }
+    const T&    operator[](int i) const { return Data[i]; }
+    T*          begin() { return Data; }
+    const T*    begin() const { return Data; }
+    T*          end() { return Data + Size; }
+    const T*    end() const { return Data + Size; }
+    T&          back() { return Data[Size - 1]; }
+
+    void        clear() { free(Data); Data = NULL; Size = Capacity = 0; }
+    int         _grow_capacity(int sz) const { int new_capacity = Capacity ? (Capacity + Capacity / 2) : 8; return new_capacity > sz ? new_capacity : sz; }
+    void        reserve(int new_capacity) { if (new_capacity <= Capacity) return; T* new_data = (T*)malloc((size_t)new_capacity * sizeof(T)); if (Data) memcpy(new_data, Data, (size_t)Size * sizeof(T)); free(Data); Data = new_data; Capacity = new_capacity; }
+    void        resize(int new_size) { if (new_size > Capacity) reserve(_grow_capacity(new_size)); Size = new_size; }
+    void        resize(int new_size, const T& v) { if (new_size > Capacity) reserve(_grow_capacity(new_size)); for (int n = Size; n < new_size; n++) memcpy(&Data[n], &v, sizeof(v)); Size = new_size; }
+    void        push_back(const T& v) { if (Size == Capacity) reserve(_grow_capacity(Size + 1)); memcpy(&Data[Size], &v, sizeof(v)); Size++; }
+    void        pop_back() { Size--; }
+    T*          erase(const T* it) { const ptrdiff_t off = it - Data; memmove(Data + off, Data + off + 1, ((size_t)Size - (size_t)off - 1) * sizeof(T)); Size--; return Data + off; }
+    T*          erase(const T* it, const T* it_last) { const ptrdiff_t count = it_last - it; const ptrdiff_t off = it - Data; memmove(Data + off, Data + off + count, ((size_t)Size - (size_t)off - (size_t)count) * sizeof(T)); Size -= (int)count; return Data + off; }
+    T*          insert(const T* it, const T& v) { const ptrdiff_t off = it - Data; if (Size == Capacity) reserve(_grow_capacity(Size + 1)); if (off < (ptrdiff_t)Size) memmove(Data + off + 1, Data + off, ((size_t)Size - (size_t)off) * sizeof(T)); memcpy(&Data[off], &v, sizeof(v)); Size++; return Data + off; }
+};
+
+struct ImDrawVert
+{
+    ImVec2      pos;
+    ImVec2      uv;
+    ImU32       col;
+};
+
+struct ImDrawListSharedData
+{
+    ImVec2      TexUvWhitePixel;
+};
+
+// Records vertices and indices, the Add*() shapes are no-ops
+struct ImDrawList
+{
+    ImVector<ImDrawIdx>     IdxBuffer;
+    ImVector<ImDrawVert>    VtxBuffer;
+    const ImDrawListSharedData* _Data = NULL;
+    unsigned int            _VtxCurrentIdx = 0;
+    ImDrawVert*             _VtxWritePtr = NULL;
+    ImDrawIdx*              _IdxWritePtr = NULL;
+
+    void PrimReserve(int idx_count, int vtx_count)
+    {
+        const int vtx_offset = VtxBuffer.Size;
+        VtxBuffer.resize(vtx_offset + vtx_count);
+        _VtxWritePtr = VtxBuffer.Data + vtx_offset;
+        const int idx_offset = IdxBuffer.Size;
+        IdxBuffer.resize(idx_offset + idx_count);
+        _IdxWritePtr = IdxBuffer.Data + idx_offset;
+    }
+    void PrimUnreserve(int idx_count, int vtx_count) { VtxBuffer.Size -= vtx_count; IdxBuffer.Size -= idx_count; }
+    void PrimWriteVtx(const ImVec2& pos, const ImVec2& uv, ImU32 col) { _VtxWritePtr->pos = pos; _VtxWritePtr->uv = uv; _VtxWritePtr->col = col; _VtxWritePtr++; _VtxCurrentIdx++; }
+    void PrimWriteIdx(ImDrawIdx idx) { *_IdxWritePtr = idx; _IdxWritePtr++; }
+
+    void AddRectFilled(const ImVec2&, const ImVec2&, ImU32, float = 0.0f, int = 0) {}
+    void AddRect(const ImVec2&, const ImVec2&, ImU32, float = 0.0f, int = 0, float = 1.0f) {}
+    void AddTriangleFilled(const ImVec2&, const ImVec2&, const ImVec2&, ImU32) {}
+    void AddLine(const ImVec2&, const ImVec2&, ImU32, float = 1.0f) {}
+};
+
+namespace ImGui
+{
+    // Context, style, time
+    ImGuiContext*   GetCurrentContext();
+    ImGuiIO&        GetIO();
+    ImGuiStyle&     GetStyle();
+    double          GetTime();
+    int             GetFrameCount();
+    void            StyleColorsDark(ImGuiStyle* dst = NULL);
+    const char*     GetStyleColorName(ImGuiCol idx);
+    ImGuiID         GetID(const char* str_id);
+    ImGuiID         GetID(const void* ptr_id);
+    ImU32           GetColorU32(ImGuiCol idx, float alpha_mul = 1.0f);
+    ImU32           ColorConvertFloat4ToU32(const ImVec4& in);
+    ImVec4          ColorConvertU32ToFloat4(ImU32 in);
+    void            PushStyleColor(ImGuiCol idx, const ImVec4& col);
+    void            PopStyleColor(int count = 1);
+
+    // Windows and widgets
+    bool            Begin(const char* name, bool* p_open = NULL, ImGuiWindowFlags flags = 0);
+    void            End();
+    void            Text(const char* fmt, ...);
+    void            TextWrapped(const char* fmt, ...);
+    void            TextDisabled(const char* fmt, ...);
+    void            TextUnformatted(const char* text, const char* text_end = NULL);
+    void            Separator();
+    void            SameLine(float offset_from_start_x = 0.0f, float spacing = -1.0f);
+    void            BeginGroup();
+    void            EndGroup();
+    void            Dummy(const ImVec2& size);
+    bool            TreeNode(const char* label);
+    void            TreePop();
+    bool            Button(const char* label, const ImVec2& size = ImVec2(0, 0));
+    bool            InvisibleButton(const char* str_id, const ImVec2& size, ImGuiButtonFlags flags = 0);
+    bool            ColorEdit4(const char* label, float col[4], ImGuiColorEditFlags flags = 0);
+    void            PlotHistogram(const char* label, const float* values, int values_count, int values_offset = 0, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0, 0), int stride = sizeof(float));
+    void            PlotLines(const char* label, const float* values, int values_count, int values_offset = 0, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0, 0), int stride = sizeof(float));
+    bool            BeginTable(const char* str_id, int column, int flags = 0, const ImVec2& outer_size = ImVec2(0.0f, 0.0f), float inner_width = 0.0f);
+    void            EndTable();
+    void            TableNextRow(int row_flags = 0, float min_row_height = 0.0f);
+    bool            TableNextColumn();
+    void            TableSetupColumn(const char* label, int flags = 0, float init_width_or_weight = 0.0f, ImGuiID user_id = 0);
+    void            TableHeadersRow();
+
+    // Layout, items, input
+    ImDrawList*     GetWindowDrawList();
+    ImVec2          GetCursorScreenPos();
+    void            SetCursorScreenPos(const ImVec2& pos);
+    float           CalcItemWidth();
+    float           GetFrameHeight();
+    ImVec2          CalcTextSize(const char* text, const char* text_end = NULL, bool hide_text_after_double_hash = false, float wrap_width = -1.0f);
+    void            PushID(int int_id);
+    void            PushID(const char* str_id);
+    void            PopID();
+    bool            IsItemActive();
+    bool            IsItemActivated();
+    bool            IsItemHovered(int flags = 0);
+    bool            IsItemClicked(ImGuiMouseButton mouse_button = 0);
+    bool            IsMouseClicked(ImGuiMouseButton button, bool repeat = false);
+    bool            IsMouseDoubleClicked(ImGuiMouseButton button);
+    ImVec2          GetMousePos();
+    void            SetMouseCursor(int cursor_type);
+}
+
+// Test hooks: advances the clock by dt seconds and the frame counter by one
+void StubNewFrame(float dt);
+// Test hooks: state of the last item (IsItemActivated(), IsItemActive()) and of the mouse, until changed
+void StubSetItemState(bool activated, bool active);
+void StubSetMouse(const ImVec2& pos, bool double_clicked = false);
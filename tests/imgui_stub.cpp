@@ -0,0 +1,136 @@
+// Implementation of the imgui.h stand-in: a fake clock and frame counter, widgets that only report the item state set by the tests
+#include "imgui.h"
+
+static ImGuiIO              GIO;
+static ImGuiStyle*          GStyle = NULL;
+static double               GTime = 0.0;
+static int                  GFrame = 0;
+static ImDrawListSharedData GDrawListData;
+static ImDrawList           GDrawList;
+static bool                 GItemActivated = false;
+static bool                 GItemActive = false;
+static bool                 GMouseDoubleClicked = false;
+
+static const char* const    GColorNames[ImGuiCol_COUNT] =
+{
+    "Text", "TextDisabled", "WindowBg", "ChildBg", "PopupBg", "Border", "BorderShadow", "FrameBg", "FrameBgHovered",
+    "FrameBgActive", "TitleBg", "TitleBgActive", "TitleBgCollapsed", "MenuBarBg", "ScrollbarBg", "ScrollbarGrab",
+    "ScrollbarGrabHovered", "ScrollbarGrabActive", "CheckMark", "SliderGrab", "SliderGrabActive", "Button", "ButtonHovered",
+    "ButtonActive", "Header", "HeaderHovered", "HeaderActive", "Separator", "SeparatorHovered", "SeparatorActive",
+    "ResizeGrip", "ResizeGripHovered", "ResizeGripActive", "Tab", "TabHovered", "TabActive", "TabUnfocused",
+    "TabUnfocusedActive", "PlotLines", "PlotLinesHovered", "PlotHistogram", "PlotHistogramHovered", "TableHeaderBg",
+    "TableBorderStrong", "TableBorderLight", "TableRowBg", "TableRowBgAlt", "TextSelectedBg", "DragDropTarget",
+    "NavHighlight", "NavWindowingHighlight", "NavWindowingDimBg", "ModalWindowDimBg"
+};
+
+void StubNewFrame(float dt)
+{
+    GIO.DeltaTime = dt;
+    GTime += dt;
+    GFrame++;
+}
+
+void StubSetItemState(bool activated, bool active)
+{
+    GItemActivated = activated;
+    GItemActive = active;
+}
+
+void StubSetMouse(const ImVec2& pos, bool double_clicked)
+{
+    GIO.MousePos = pos;
+    GMouseDoubleClicked = double_clicked;
+}
+
+ImGuiStyle::ImGuiStyle()
+{
+    memset((void*)this, 0, sizeof(*this));
+    ImGui::StyleColorsDark(this);
+}
+
+static int Saturate(float f)
+{
+    f = f < 0.0f ? 0.0f : f > 1.0f ? 1.0f : f;
+    return (int)(f * 255.0f + 0.5f);
+}
+
+namespace ImGui
+{
+    ImGuiContext*   GetCurrentContext() { return (ImGuiContext*)&GIO; }
+    ImGuiIO&        GetIO() { return GIO; }
+    ImGuiStyle&     GetStyle() { if (!GStyle) GStyle = new ImGuiStyle(); return *GStyle; }
+    double          GetTime() { return GTime; }
+    int             GetFrameCount() { return GFrame; }
+    const char*     GetStyleColorName(ImGuiCol idx) { return GColorNames[idx]; }
+
+    // Distinct colors per slot, the values do not matter
+    void StyleColorsDark(ImGuiStyle* dst)
+    {
+        ImGuiStyle* style = dst ? dst : &GetStyle();
+        for (int i = 0; i < ImGuiCol_COUNT; i++)
+            style->Colors[i] = ImVec4(0.1f * (i % 10), 0.2f, 0.3f, 1.0f);
+    }
+
+    // FNV-1a, like ImCandy::ThemeRegistry::HashName()
+    ImGuiID GetID(const char* str_id)
+    {
+        ImGuiID hash = 2166136261u;
+        while (*str_id)
+            hash = (hash ^ (unsigned char)*str_id++) * 16777619u;
+        return hash;
+    }
+    ImGuiID GetID(const void* ptr_id) { return (ImGuiID)(size_t)ptr_id; }
+
+    ImU32 ColorConvertFloat4ToU32(const ImVec4& in) { return IM_COL32(Saturate(in.x), Saturate(in.y), Saturate(in.z), Saturate(in.w)); }
+    ImVec4 ColorConvertU32ToFloat4(ImU32 in)
+    {
+        const float s = 1.0f / 255.0f;
+        return ImVec4((in & 0xFF) * s, ((in >> 8) & 0xFF) * s, ((in >> 16) & 0xFF) * s, ((in >> 24) & 0xFF) * s);
+    }
+    ImU32 GetColorU32(ImGuiCol idx, float) { return ColorConvertFloat4ToU32(GetStyle().Colors[idx]); }
+    void PushStyleColor(ImGuiCol, const ImVec4&) {}
+    void PopStyleColor(int) {}
+
+    bool Begin(const char*, bool*, ImGuiWindowFlags) { return true; }
+    void End() {}
+    void Text(const char*, ...) {}
+    void TextWrapped(const char*, ...) {}
+    void TextDisabled(const char*, ...) {}
+    void TextUnformatted(const char*, const char*) {}
+    void Separator() {}
+    void SameLine(float, float) {}
+    void BeginGroup() {}
+    void EndGroup() {}
+    void Dummy(const ImVec2&) {}
+    bool TreeNode(const char*) { return true; }
+    void TreePop() {}
+    bool Button(const char*, const ImVec2&) { return false; }
+    bool InvisibleButton(const char*, const ImVec2&, ImGuiButtonFlags) { return false; }
+    bool ColorEdit4(const char*, float*, ImGuiColorEditFlags) { return false; }
+    void PlotHistogram(const char*, const float*, int, int, const char*, float, float, ImVec2, int) {}
+    void PlotLines(const char*, const float*, int, int, const char*, float, float, ImVec2, int) {}
+    bool BeginTable(const char*, int, int, const ImVec2&, float) { return true; }
+    void EndTable() {}
+    void TableNextRow(int, float) {}
+    bool TableNextColumn() { return true; }
+    void TableSetupColumn(const char*, int, float, ImGuiID) {}
+    void TableHeadersRow() {}
+
+    ImDrawList* GetWindowDrawList() { GDrawList._Data = &GDrawListData; return &GDrawList; }
+    ImVec2 GetCursorScreenPos() { return ImVec2(); }
+    void SetCursorScreenPos(const ImVec2&) {}
+    float CalcItemWidth() { return 200.0f; }
+    float GetFrameHeight() { return 19.0f; }
+    ImVec2 CalcTextSize(const char*, const char*, bool, float) { return ImVec2(10.0f, 10.0f); }
+    void PushID(int) {}
+    void PushID(const char*) {}
+    void PopID() {}
+    bool IsItemActive() { return GItemActive; }
+    bool IsItemActivated() { return GItemActivated; }
+    bool IsItemHovered(int) { return false; }
+    bool IsItemClicked(ImGuiMouseButton) { return false; }
+    bool IsMouseClicked(ImGuiMouseButton, bool) { return false; }
+    bool IsMouseDoubleClicked(ImGuiMouseButton) { return GMouseDoubleClicked; }
+    ImVec2 GetMousePos() { return GIO.MousePos; }
+    void SetMouseCursor(int) {}
+}
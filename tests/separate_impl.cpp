@@ -0,0 +1,3 @@
+// The one translation unit compiling the ImCandy functions for test_separate_implementation
+#define IMCANDY_IMPLEMENTATION
+#include "candy.h"
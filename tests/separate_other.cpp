@@ -0,0 +1,8 @@
+// Second translation unit using ImCandy, see test_separate_implementation.cpp
+#include "candy.h"
+#include "themefile.h"
+
+ImCandy::Animator* OtherAnimator() { return &ImCandy::GetAnimator(); }
+ImCandy::StyleBindings* OtherBindings() { return &ImCandy::GetStyleBindings(); }
+
+ImVec4 OtherRainbow(double ratio) { return ImCandy::Rainbow(ratio); }
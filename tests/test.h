@@ -0,0 +1,27 @@
+// Minimal checks for the unit tests: a failed CHECK prints its location and the test exits with 1
+#pragma once
+
+#include <math.h>
+#include <stdio.h>
+
+static int TestFailures = 0;
+
+#define CHECK(_EXPR)                                                                        \
+    do {                                                                                    \
+        if (!(_EXPR)) {                                                                     \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #_EXPR);       \
+            TestFailures++;                                                                 \
+        }                                                                                   \
+    } while (0)
+
+#define CHECK_NEAR(_A, _B, _EPS)                                                            \
+    do {                                                                                    \
+        const double _a = double(_A), _b = double(_B);                                      \
+        if (!(fabs(_a - _b) <= double(_EPS))) {                                             \
+            fprintf(stderr, "%s:%d: CHECK_NEAR(%s, %s) failed: %g vs %g\n",                 \
+                    __FILE__, __LINE__, #_A, #_B, _a, _b);                                  \
+            TestFailures++;                                                                 \
+        }                                                                                   \
+    } while (0)
+
+#define TEST_RESULT() (TestFailures == 0 ? 0 : 1)
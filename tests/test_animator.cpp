@@ -0,0 +1,94 @@
+// Time-based Animator: frame caching, speed in cycles per second, the FPS cap and the next-change query
+#include "candy.h"
+#include "test.h"
+
+static void TestAnimate()
+{
+    ImCandy::Animator animator;
+    const ImCandy::Gradient<3> g = {{ ImVec4(0, 0, 0, 1), ImVec4(1, 1, 1, 1), ImVec4(0, 0, 0, 1) }};
+    StubNewFrame(1.0f);
+
+    // One cycle per second runs through the whole gradient: the phase is the time modulo 1
+    const float t0 = float(ImGui::GetTime());
+    const ImVec4 first = animator.Animate(1, g, 1.0f);
+    CHECK_NEAR(first.x, g.Evaluate((t0 - floor(t0)) * 2.0).x, 1e-5f);
+
+    // Within a frame an id keeps its first color, whatever the later arguments
+    CHECK_NEAR(animator.Animate(1, g, 5.0f, 0.5f).x, first.x, 0.0f);
+
+    // Other ids are independent, the phase is in cycles
+    CHECK_NEAR(animator.Animate(2, g, 1.0f, 0.5f).x, g.Evaluate((t0 + 0.5 - floor(t0 + 0.5)) * 2.0).x, 1e-5f);
+
+    // A quarter second later a quarter cycle has passed, at any frame rate
+    StubNewFrame(0.25f);
+    const double t1 = ImGui::GetTime();
+    CHECK_NEAR(animator.Animate(1, g, 1.0f).x, g.Evaluate((t1 - floor(t1)) * 2.0).x, 1e-5f);
+}
+
+static void TestMaxFPS()
+{
+    ImCandy::Animator animator;
+    animator.MaxFPS = 10.0f;
+    const ImCandy::Gradient<2> g = {{ ImVec4(0, 0, 0, 1), ImVec4(1, 1, 1, 1) }};
+
+    // Time is quantized to 0.1 s, so frames 0.01 s apart see the same color
+    StubNewFrame(1.0f - float(ImGui::GetTime() - floor(ImGui::GetTime())) + 0.02f);
+    const float color = animator.Animate(1, g, 0.1f).x;
+    StubNewFrame(0.01f);
+    CHECK_NEAR(animator.Animate(1, g, 0.1f).x, color, 0.0f);
+}
+
+static void TestTimeUntilNextChange()
+{
+    ImCandy::Animator animator;
+    CHECK(animator.GetTimeUntilNextChange() == FLT_MAX);
+
+    // A full black to white ramp per second changes by one 8-bit step every 1/255 s, counted from time 0
+    const ImCandy::Gradient<2> g = {{ ImVec4(0, 0, 0, 1), ImVec4(1, 1, 1, 1) }};
+    StubNewFrame(0.016f);
+    animator.Animate(1, g, 1.0f);
+    const double quantum = 1.0 / 255.0;
+    CHECK_NEAR(animator.GetTimeUntilNextChange(), float(quantum - fmod(ImGui::GetTime(), quantum)), 1e-6f);
+    CHECK(animator.GetTimeUntilNextChange() <= 1.0f / 255.0f);
+
+    // With a cap the wait ends on the next boundary of the quantized time: half a period from the middle of one
+    animator.MaxFPS = 30.0f;
+    StubNewFrame(float(ceil(ImGui::GetTime() * 30.0) / 30.0 - ImGui::GetTime() + 0.5 / 30.0));
+    animator.Animate(1, g, 1.0f);
+    CHECK_NEAR(animator.GetTimeUntilNextChange(), 0.5f / 30.0f, 1e-4f);
+
+    // Slower colors wait whole periods: a step every 0.05 s is rounded up to 2 periods
+    StubNewFrame(1.0f / 30.0f);
+    animator.Clear();
+    animator.Animate(1, g, float(quantum / 0.05));
+    const double now = ImGui::GetTime();
+    CHECK_NEAR(animator.GetTimeUntilNextChange(), float(2.0 / 30.0 - fmod(now, 2.0 / 30.0)), 1e-4f);
+    CHECK(animator.GetTimeUntilNextChange() <= 2.0f / 30.0f);
+    animator.MaxFPS = 0.0f;
+
+    // Constant colors never need a redraw
+    ImCandy::Animator still;
+    const ImCandy::Gradient<2> flat = {{ ImVec4(0.5f, 0.5f, 0.5f, 1), ImVec4(0.5f, 0.5f, 0.5f, 1) }};
+    still.Animate(1, flat, 1.0f);
+    CHECK(still.GetTimeUntilNextChange() == FLT_MAX);
+
+    // Ids animated in the previous frame still count, older ones do not
+    StubNewFrame(0.016f);
+    CHECK(animator.GetTimeUntilNextChange() < FLT_MAX);
+    StubNewFrame(0.016f);
+    CHECK(animator.GetTimeUntilNextChange() == FLT_MAX);
+
+    // Compact() forgets idle ids
+    animator.Compact(0);
+    StubNewFrame(0.016f);
+    animator.Animate(2, g, 1.0f);
+    CHECK(animator.GetTimeUntilNextChange() < FLT_MAX);
+}
+
+int main()
+{
+    TestAnimate();
+    TestMaxFPS();
+    TestTimeUntilNextChange();
+    return TEST_RESULT();
+}
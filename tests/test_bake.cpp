@@ -0,0 +1,145 @@
+// Baked tables: BakedGradient, compile-time GradientTable, Colormap and ColormapImage, including partial re-bakes
+#include <vector>
+#define IMCANDYCONSTS
+#include "candy.h"
+#include "test.h"
+
+using namespace gradient;
+
+static bool PackedNear(std::uint32_t a, std::uint32_t b, int tolerance)
+{
+    for (int i = 0; i < 32; i += 8)
+        if (abs(int((a >> i) & 0xFF) - int((b >> i) & 0xFF)) > tolerance)
+            return false;
+    return true;
+}
+
+static void Fill(FlatLinearColor4Gradient& g)
+{
+    g[0.0f] = Color4{ 1.0f, 0.0f, 0.0f, 1.0f };
+    g[0.3f] = Color4{ 1.0f, 1.0f, 0.0f, 1.0f };
+    g[0.7f] = Color4{ 0.0f, 0.5f, 1.0f, 1.0f };
+    g[1.0f] = Color4{ 0.2f, 0.0f, 0.4f, 0.5f };
+}
+
+static void TestBakedGradient()
+{
+    FlatLinearColor4Gradient g;
+    Fill(g);
+    BakedGradient<float> baked(g, 1024);
+    CHECK(baked.size() == 1024);
+    CHECK(baked.firstKey() == 0.0f && baked.lastKey() == 1.0f);
+
+    // A table of 1024 entries is within one 8-bit step of the gradient, nearest within two
+    std::uint32_t exact;
+    for (int i = 0; i <= 1000; i++)
+    {
+        const float point = float(i) / 1000.0f;
+        g.evaluate(&point, 1, &exact);
+        CHECK(PackedNear(baked.lerp(point), exact, 1));
+        CHECK(PackedNear(baked.nearest(point), exact, 2));
+    }
+    CHECK(baked.nearest(-1.0f) == baked.data()[0]);
+    CHECK(baked.lerp(2.0f) == baked.data()[1023]);
+
+    // update() re-samples the two segments around the edited stop and gives the same table as a full bake
+    g.set(0.3f, Color4{ 0.0f, 0.0f, 0.0f, 1.0f });
+    const std::size_t resampled = baked.update(g);
+    CHECK(resampled > 0 && resampled < 1024 * 3 / 4);
+    const BakedGradient<float> rebaked(g, 1024);
+    CHECK(std::equal(baked.data(), baked.data() + baked.size(), rebaked.data()));
+    CHECK(baked.update(g) == 0);
+}
+
+static void TestCompileTimeTable()
+{
+    static constexpr ImCandy::GradientTable<256> table = ImCandy::MakeTable<256>(ImCandy::RainbowGradient());
+    static_assert(table.Colors[0] == IM_COL32(255, 0, 0, 255), "the rainbow starts red");
+    static constexpr ImCandy::GradientTable<64> violet = ImCandy::MakeTable<64>(ImCandy::Gradient<3>{{ IV4_VIOLET, IV4_BUBBLEGUM, IV4_VIOLET }});
+    static_assert(violet.Colors[0] == violet.Colors[63], "the IV4_* constants are usable in constant expressions");
+    const ImCandy::RainbowGradient rainbow;
+    for (int i = 0; i < 256; i++)
+        CHECK(table.Colors[i] == ImGui::ColorConvertFloat4ToU32(rainbow.Evaluate(i * 6.0 / 255.0)));
+
+    const gradient::BakedGradient<> baked = ImCandy::Bake(rainbow, 256);
+    CHECK(std::equal(baked.data(), baked.data() + 256, table.Colors));
+
+    // The table keeps the gradient.h layout, Step() hands out IM_COL32 colors
+    CHECK(baked.data()[0] == 0xFF0000FFu);
+    double ratio = 0.0;
+    CHECK(ImCandy::Step(baked, ratio, 0.5, false) == IM_COL32(255, 0, 0, 255));
+    CHECK(ratio == 0.5);
+}
+
+static void TestColormap()
+{
+    FlatLinearColor4Gradient g;
+    Fill(g);
+    ImCandy::Colormap map(g);
+    map.SetRange(10.0f, 20.0f);
+    CHECK(map.Map(0.0f) == map.GetTable()[0]);
+    CHECK(map.Map(100.0f) == map.GetTable()[ImCandy::Colormap::Resolution - 1]);
+    CHECK(map.Map(NAN) == map.GetTable()[0]);
+
+    // Every input byte goes through the same table as the float path
+    ImU8 bytes[256];
+    ImU32 from_bytes[256];
+    for (int i = 0; i < 256; i++)
+        bytes[i] = ImU8(i);
+    map.SetRange(0.0f, 255.0f);
+    map.Map(bytes, 256, from_bytes);
+    for (int i = 0; i < 256; i++)
+        CHECK(from_bytes[i] == map.Map(float(i)));
+
+    // Partial update of the table, then of the image pixels using the changed entries
+    ImCandy::ColormapImage image(16, 4);
+    image.Map = map;
+    std::vector<float> field(16 * 4);
+    for (int i = 0; i < 64; i++)
+        field[i] = float(i % 16) * 17.0f;
+    image.SetData(field.data(), 16);
+    CHECK(*image.GetPixels(3, 2) == map.Map(field[2 * 16 + 3]));
+    int x = 0, y = 0, w = 0, h = 0;
+    CHECK(image.GetDirtyRect(&x, &y, &w, &h));
+    CHECK(x == 0 && y == 0 && w == 16 && h == 4);
+    image.ClearDirty();
+
+    g.set(0.0f, Color4{ 0.0f, 1.0f, 0.0f, 1.0f });
+    CHECK(image.UpdateMap(g));
+    CHECK(image.GetDirtyRect(&x, &y, &w, &h));
+    CHECK(x == 0 && w < 16 && h == 4);
+    CHECK(*image.GetPixels(0, 0) == ImCandy::Colormap(g).GetTable()[0]);
+
+    // Recolor skips the rows that use none of the changed entries, also after a partial update
+    ImCandy::ColormapImage rows(16, 4);
+    rows.Map = map;
+    for (int i = 0; i < 64; i++)
+        field[i] = i < 16 ? 0.0f : 255.0f;
+    rows.SetData(field.data(), 16);
+    field[2 * 16 + 5] = 128.0f;
+    rows.Update(field.data(), 16, 5, 2, 1, 1);
+    rows.ClearDirty();
+    rows.Recolor(0, 10);
+    CHECK(rows.GetDirtyRect(&x, &y, &w, &h));
+    CHECK(x == 0 && y == 0 && w == 16 && h == 1);
+    rows.ClearDirty();
+    rows.Recolor(120, 135);
+    CHECK(rows.GetDirtyRect(&x, &y, &w, &h));
+    CHECK(x == 5 && y == 2 && w == 1 && h == 1);
+    rows.ClearDirty();
+    rows.Recolor(1, 100);
+    CHECK(!rows.GetDirtyRect(&x, &y, &w, &h));
+
+    // Resize starts from cleared pixels
+    image.Resize(32, 32);
+    for (int i = 0; i < 32; i++)
+        CHECK(*image.GetPixels(i, i) == 0);
+}
+
+int main()
+{
+    TestBakedGradient();
+    TestCompileTimeTable();
+    TestColormap();
+    return TEST_RESULT();
+}
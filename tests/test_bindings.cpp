@@ -0,0 +1,126 @@
+// Style bindings: batched evaluation against Animator::Animate(), slots, roles, rebinding and the next-change query
+#include "candy.h"
+#include "test.h"
+
+static bool Near(const ImVec4& a, const ImVec4& b, float eps = 1e-5f)
+{
+    return fabsf(a.x - b.x) <= eps && fabsf(a.y - b.y) <= eps && fabsf(a.z - b.z) <= eps && fabsf(a.w - b.w) <= eps;
+}
+
+static const ImCandy::Gradient<3> Violet = {{ ImVec4(0.5f, 0, 1, 1), ImVec4(1, 0.5f, 0.5f, 1), ImVec4(0.5f, 0, 1, 1) }};
+static const ImCandy::Gradient<2> Ramp = {{ ImVec4(0, 0, 0, 1), ImVec4(1, 1, 1, 0) }};
+
+static void TestUpdate()
+{
+    ImCandy::StyleBindings bindings;
+    ImCandy::Animator animator;
+    bindings.Bind(ImGuiCol_Border, ImCandy::RainbowGradient(), 0.6f);
+    bindings.Bind(ImGuiCol_Button, Violet, 0.3f, 0.25f);
+    bindings.Bind("accent", Ramp, 1.0f);
+    CHECK(bindings.GetCount() == 3);
+
+    // Unbound until the first Update()
+    CHECK(Near(bindings.GetColor("accent"), ImVec4(0, 0, 0, 0)));
+
+    // Same colors as animating each gradient on its own
+    for (int frame = 0; frame < 4; frame++)
+    {
+        StubNewFrame(0.37f);
+        bindings.Update();
+        CHECK(Near(bindings.GetColor(ImGuiCol_Border), animator.Animate(1, ImCandy::RainbowGradient(), 0.6f)));
+        CHECK(Near(bindings.GetColor(ImGuiCol_Button), animator.Animate(2, Violet, 0.3f, 0.25f)));
+        CHECK(Near(bindings.GetColor("accent"), animator.Animate(3, Ramp, 1.0f)));
+    }
+    CHECK(Near(bindings.GetColor(ImGuiCol_Text), ImVec4(0, 0, 0, 0)));
+
+    // Apply() writes the slots only
+    ImGuiStyle style;
+    const ImVec4 text = style.Colors[ImGuiCol_Text];
+    bindings.Apply(&style);
+    CHECK(Near(style.Colors[ImGuiCol_Border], bindings.GetColor(ImGuiCol_Border), 0.0f));
+    CHECK(Near(style.Colors[ImGuiCol_Button], bindings.GetColor(ImGuiCol_Button), 0.0f));
+    CHECK(Near(style.Colors[ImGuiCol_Text], text, 0.0f));
+}
+
+static void TestRebinding()
+{
+    ImCandy::StyleBindings bindings;
+    ImCandy::Animator animator;
+    bindings.Bind(ImGuiCol_Border, Violet, 0.5f);
+    bindings.Bind("accent", Ramp, 1.0f);
+    bindings.Bind(ImGuiCol_Button, Ramp, 0.25f);
+
+    // Binding a slot again replaces it, unbinding compacts the shared stops
+    bindings.Bind(ImGuiCol_Border, Ramp, 2.0f);
+    CHECK(bindings.GetCount() == 3);
+    bindings.Unbind("accent");
+    bindings.Unbind("missing");
+    CHECK(bindings.GetCount() == 2);
+
+    StubNewFrame(0.11f);
+    bindings.Update();
+    CHECK(Near(bindings.GetColor(ImGuiCol_Border), animator.Animate(1, Ramp, 2.0f)));
+    CHECK(Near(bindings.GetColor(ImGuiCol_Button), animator.Animate(2, Ramp, 0.25f)));
+    CHECK(Near(bindings.GetColor("accent"), ImVec4(0, 0, 0, 0)));
+
+    // Until the next Update() the remaining bindings keep their own colors
+    const ImVec4 border_before = bindings.GetColor(ImGuiCol_Border);
+    bindings.Unbind(ImGuiCol_Button);
+    CHECK(Near(bindings.GetColor(ImGuiCol_Border), border_before, 0.0f));
+    CHECK(Near(bindings.GetColor(ImGuiCol_Button), ImVec4(0, 0, 0, 0)));
+
+    // Later Update() calls in the same frame keep the colors
+    const ImVec4 border = bindings.GetColor(ImGuiCol_Border);
+    bindings.Update();
+    CHECK(Near(bindings.GetColor(ImGuiCol_Border), border, 0.0f));
+
+    bindings.Clear();
+    CHECK(bindings.GetCount() == 0);
+    bindings.Update();
+    CHECK(Near(bindings.GetColor(ImGuiCol_Border), ImVec4(0, 0, 0, 0)));
+}
+
+static void TestSharedBindings()
+{
+    ImCandy::StyleBindings& bindings = ImCandy::GetStyleBindings();
+    bindings.Bind(ImGuiCol_FrameBg, Ramp, 0.5f);
+    StubNewFrame(0.2f);
+    ImGuiStyle style;
+    ImCandy::UpdateBindings(&style);
+    CHECK(Near(style.Colors[ImGuiCol_FrameBg], bindings.GetColor(ImGuiCol_FrameBg), 0.0f));
+    bindings.Clear();
+}
+
+static void TestTimeUntilNextChange()
+{
+    ImCandy::StyleBindings bindings;
+    CHECK(bindings.GetTimeUntilNextChange() == FLT_MAX);
+
+    // Same rate as the animator: the steepest stop interval, however long ago the last Update() was
+    bindings.Bind("accent", Ramp, 1.0f);
+    const double quantum = 1.0 / 255.0;
+    CHECK_NEAR(bindings.GetTimeUntilNextChange(), float(quantum - fmod(ImGui::GetTime(), quantum)), 1e-6f);
+    bindings.MaxFPS = 30.0f;
+    StubNewFrame(float(ceil(ImGui::GetTime() * 30.0) / 30.0 - ImGui::GetTime() + 0.25 / 30.0));
+    CHECK_NEAR(bindings.GetTimeUntilNextChange(), 0.75f / 30.0f, 1e-4f);
+    bindings.Unbind("accent");
+    CHECK(bindings.GetTimeUntilNextChange() == FLT_MAX);
+
+    // The free function covers the shared bindings even when the shared animator is idle
+    StubNewFrame(1.0f);
+    StubNewFrame(1.0f);
+    CHECK(ImCandy::GetAnimator().GetTimeUntilNextChange() == FLT_MAX);
+    CHECK(ImCandy::GetTimeUntilNextChange() == FLT_MAX);
+    ImCandy::GetStyleBindings().Bind(ImGuiCol_Border, Ramp, 0.5f);
+    CHECK_NEAR(ImCandy::GetTimeUntilNextChange(), float(2.0 * quantum - fmod(ImGui::GetTime(), 2.0 * quantum)), 1e-6f);
+    ImCandy::GetStyleBindings().Clear();
+}
+
+int main()
+{
+    TestUpdate();
+    TestRebinding();
+    TestSharedBindings();
+    TestTimeUntilNextChange();
+    return TEST_RESULT();
+}
@@ -0,0 +1,135 @@
+// ImDrawList gradient fills: vertex and index counts, positions and colors of DrawGradientRect/Line/Border
+#include "candy.h"
+#include "test.h"
+
+using namespace gradient;
+
+static ImDrawList* NewDrawList()
+{
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    draw_list->VtxBuffer.clear();
+    draw_list->IdxBuffer.clear();
+    draw_list->_VtxCurrentIdx = 0;
+    return draw_list;
+}
+
+// Every triangle refers to vertices written by the same call
+static bool IndicesInRange(const ImDrawList* draw_list)
+{
+    for (int i = 0; i < draw_list->IdxBuffer.Size; i++)
+        if (draw_list->IdxBuffer[i] >= draw_list->VtxBuffer.Size)
+            return false;
+    return true;
+}
+
+static void TestRect()
+{
+    const ImCandy::Gradient<3> g = {{ ImVec4(1, 0, 0, 1), ImVec4(0, 1, 0, 1), ImVec4(0, 0, 1, 1) }};
+
+    // One vertex pair per stop, two triangles between pairs
+    ImDrawList* draw_list = NewDrawList();
+    ImCandy::DrawGradientRect(draw_list, ImVec2(10, 20), ImVec2(110, 40), g);
+    CHECK(draw_list->VtxBuffer.Size == 6);
+    CHECK(draw_list->IdxBuffer.Size == 12);
+    CHECK(IndicesInRange(draw_list));
+    const ImDrawVert* v = draw_list->VtxBuffer.Data;
+    CHECK(v[0].pos.x == 10.0f && v[0].pos.y == 20.0f && v[1].pos.x == 10.0f && v[1].pos.y == 40.0f);
+    CHECK(v[2].pos.x == 60.0f && v[4].pos.x == 110.0f);
+    CHECK(v[0].col == IM_COL32(255, 0, 0, 255) && v[1].col == v[0].col);
+    CHECK(v[2].col == IM_COL32(0, 255, 0, 255));
+    CHECK(v[5].col == IM_COL32(0, 0, 255, 255));
+
+    // Vertical runs top to bottom
+    draw_list = NewDrawList();
+    ImCandy::DrawGradientRect(draw_list, ImVec2(10, 20), ImVec2(110, 40), g, true);
+    v = draw_list->VtxBuffer.Data;
+    CHECK(v[2].pos.y == 30.0f && v[4].pos.y == 40.0f);
+    CHECK(v[0].pos.x == 10.0f && v[1].pos.x == 110.0f);
+
+    // Explicit segments split every stop interval
+    draw_list = NewDrawList();
+    ImCandy::DrawGradientRect(draw_list, ImVec2(0, 0), ImVec2(100, 10), g, false, 4);
+    CHECK(draw_list->VtxBuffer.Size == 2 * (1 + 2 * 4));
+    CHECK(IndicesInRange(draw_list));
+    CHECK(draw_list->VtxBuffer[2].pos.x == 12.5f);
+}
+
+static void TestGradientSources()
+{
+    // gradient.h stops land on vertices too, with the same packing as IM_COL32
+    FlatLinearColor4Gradient flat;
+    flat[0.0f] = Color4{ 1.0f, 0.0f, 0.0f, 1.0f };
+    flat[0.25f] = Color4{ 0.0f, 1.0f, 0.0f, 1.0f };
+    flat[1.0f] = Color4{ 0.0f, 0.0f, 1.0f, 1.0f };
+    ImDrawList* draw_list = NewDrawList();
+    ImCandy::DrawGradientRect(draw_list, ImVec2(0, 0), ImVec2(100, 10), flat);
+    CHECK(draw_list->VtxBuffer.Size == 6);
+    CHECK(draw_list->VtxBuffer[2].pos.x == 25.0f);
+    CHECK(draw_list->VtxBuffer[2].col == IM_COL32(0, 255, 0, 255));
+    CHECK(draw_list->VtxBuffer[4].col == IM_COL32(0, 0, 255, 255));
+
+    // A non-linear curve is split in 8 pieces per interval by default
+    FlatLinearGradient<Color4, float, CosineInterp> eased;
+    eased[0.0f] = Color4{ 0.0f, 0.0f, 0.0f, 1.0f };
+    eased[1.0f] = Color4{ 1.0f, 1.0f, 1.0f, 1.0f };
+    draw_list = NewDrawList();
+    ImCandy::DrawGradientRect(draw_list, ImVec2(0, 0), ImVec2(80, 10), eased);
+    CHECK(draw_list->VtxBuffer.Size == 2 * 9);
+    CHECK(draw_list->VtxBuffer[8].col == IM_COL32(128, 128, 128, 255));
+
+    // Nothing to draw
+    FlatLinearColor4Gradient empty;
+    draw_list = NewDrawList();
+    ImCandy::DrawGradientRect(draw_list, ImVec2(0, 0), ImVec2(80, 10), empty);
+    CHECK(draw_list->VtxBuffer.Size == 0 && draw_list->IdxBuffer.Size == 0);
+}
+
+static void TestLine()
+{
+    const ImCandy::Gradient<2> g = {{ ImVec4(1, 0, 0, 1), ImVec4(0, 0, 1, 1) }};
+    ImDrawList* draw_list = NewDrawList();
+    ImCandy::DrawGradientLine(draw_list, ImVec2(0, 5), ImVec2(10, 5), g, 2.0f);
+    CHECK(draw_list->VtxBuffer.Size == 4);
+    CHECK(draw_list->IdxBuffer.Size == 6);
+    const ImDrawVert* v = draw_list->VtxBuffer.Data;
+    CHECK(v[0].pos.x == 0.0f && v[0].pos.y == 6.0f && v[1].pos.y == 4.0f);
+    CHECK(v[2].pos.x == 10.0f && v[2].col == IM_COL32(0, 0, 255, 255));
+
+    // Zero length lines draw nothing
+    draw_list = NewDrawList();
+    ImCandy::DrawGradientLine(draw_list, ImVec2(3, 3), ImVec2(3, 3), g);
+    CHECK(draw_list->VtxBuffer.Size == 0);
+}
+
+static void TestBorder()
+{
+    const ImCandy::Gradient<2> g = {{ ImVec4(0, 0, 0, 1), ImVec4(1, 1, 1, 1) }};
+
+    // One strip per side, all reserved at once
+    ImDrawList* draw_list = NewDrawList();
+    ImCandy::DrawGradientBorder(draw_list, ImVec2(0, 0), ImVec2(30, 20), g, 2.0f);
+    CHECK(draw_list->VtxBuffer.Size == 16);
+    CHECK(draw_list->IdxBuffer.Size == 24);
+    CHECK(IndicesInRange(draw_list));
+
+    // Clockwise from the top-left corner, keys spread over the perimeter (100)
+    const ImDrawVert* v = draw_list->VtxBuffer.Data;
+    CHECK(v[0].pos.x == 0.0f && v[0].pos.y == 0.0f && v[1].pos.x == 2.0f && v[1].pos.y == 2.0f);
+    CHECK(v[0].col == IM_COL32(0, 0, 0, 255));
+    CHECK(v[2].pos.x == 30.0f && v[2].col == IM_COL32(77, 77, 77, 255));
+    CHECK(v[15].col == IM_COL32(255, 255, 255, 255));
+
+    // Too small to have a border
+    draw_list = NewDrawList();
+    ImCandy::DrawGradientBorder(draw_list, ImVec2(0, 0), ImVec2(0, 20), g);
+    CHECK(draw_list->VtxBuffer.Size == 0);
+}
+
+int main()
+{
+    TestRect();
+    TestGradientSources();
+    TestLine();
+    TestBorder();
+    return TEST_RESULT();
+}
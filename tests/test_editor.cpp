@@ -0,0 +1,105 @@
+// GradientEditor driven through the stub's item and mouse state: add, drag, select and remove stops
+#include <algorithm>
+#include "candy.h"
+#include "test.h"
+
+using namespace gradient;
+
+// The stub places the editor at (0, 0), 200 pixels wide, with a 28.5 pixel bar and the markers below it
+static const float MarkerY = 35.0f;
+
+static float KeyX(float key) { return key * 200.0f; }
+
+// One ImGui frame of the editor with the given item and mouse state
+static bool Frame(ImCandy::GradientEditor<FlatLinearColor4Gradient>& editor, FlatLinearColor4Gradient& g,
+                  const ImVec2& mouse, bool activated, bool active, bool double_clicked = false)
+{
+    StubNewFrame(0.016f);
+    StubSetMouse(mouse, double_clicked);
+    StubSetItemState(activated, active);
+    const bool changed = editor.Draw("ramp", g);
+    StubSetItemState(false, false);
+    StubSetMouse(ImVec2(), false);
+    return changed;
+}
+
+static bool MatchesFullBake(const ImCandy::GradientEditor<FlatLinearColor4Gradient>& editor, const FlatLinearColor4Gradient& g)
+{
+    const BakedGradient<float>& baked = editor.GetBaked();
+    const BakedGradient<float> full(g, baked.size());
+    return std::equal(baked.data(), baked.data() + baked.size(), full.data());
+}
+
+static void TestEditor()
+{
+    FlatLinearColor4Gradient g;
+    g[0.0f] = Color4{ 1.0f, 0.0f, 0.0f, 1.0f };
+    g[1.0f] = Color4{ 0.0f, 0.0f, 1.0f, 1.0f };
+    ImCandy::GradientEditor<FlatLinearColor4Gradient> editor(256);
+
+    // Idle frames change nothing but bake the table
+    CHECK(!Frame(editor, g, ImVec2(100, 10), false, false));
+    CHECK(editor.GetBaked().size() == 256);
+    CHECK(MatchesFullBake(editor, g));
+    float selected = -1.0f;
+    CHECK(!editor.GetSelected(&selected));
+
+    // Clicking the bar adds a stop with the color already there and selects it
+    const Color4 middle = g(0.5f);
+    CHECK(Frame(editor, g, ImVec2(KeyX(0.5f), 10), true, true));
+    CHECK(g.size() == 3);
+    CHECK(editor.GetSelected(&selected) && selected == 0.5f);
+    const Color4 added = g[0.5f];
+    CHECK(added.r == middle.r && added.b == middle.b);
+    CHECK(MatchesFullBake(editor, g));
+
+    // Holding the button drags it, the table follows
+    CHECK(Frame(editor, g, ImVec2(KeyX(0.75f), 10), false, true));
+    CHECK(g.size() == 3);
+    CHECK(editor.GetSelected(&selected) && selected == 0.75f);
+    CHECK(MatchesFullBake(editor, g));
+
+    // Once released the mouse no longer moves it
+    CHECK(!Frame(editor, g, ImVec2(KeyX(0.25f), 10), false, false));
+    CHECK(editor.GetSelected(&selected) && selected == 0.75f);
+
+    // Clicking a marker selects its stop
+    CHECK(!Frame(editor, g, ImVec2(KeyX(0.0f), MarkerY), true, true));
+    CHECK(editor.GetSelected(&selected) && selected == 0.0f);
+    CHECK(!Frame(editor, g, ImVec2(KeyX(0.0f), MarkerY), false, false));
+
+    // Double-clicking a marker removes its stop, never below two stops
+    CHECK(Frame(editor, g, ImVec2(KeyX(0.75f), MarkerY), true, true, true));
+    CHECK(g.size() == 2);
+    CHECK(!editor.GetSelected(&selected));
+    CHECK(MatchesFullBake(editor, g));
+    CHECK(!Frame(editor, g, ImVec2(KeyX(1.0f), MarkerY), true, true, true));
+    CHECK(g.size() == 2);
+    CHECK(editor.GetSelected(&selected) && selected == 1.0f);
+    CHECK(!Frame(editor, g, ImVec2(), false, false));
+
+    // Confirming a selection does not start a drag: the bar follows a key range changed by other code
+    CHECK(!Frame(editor, g, ImVec2(KeyX(1.0f), MarkerY), true, true));
+    CHECK(!Frame(editor, g, ImVec2(), false, false));
+    g[2.0f] = Color4{ 0.0f, 1.0f, 0.0f, 1.0f };
+    CHECK(!Frame(editor, g, ImVec2(), false, false));
+    CHECK(!Frame(editor, g, ImVec2(KeyX(1.0f), MarkerY), true, true));
+    CHECK(editor.GetSelected(&selected) && selected == 2.0f);
+    CHECK(!Frame(editor, g, ImVec2(), false, false));
+    CHECK(g.erase(2.0f));
+
+    // A selected stop removed by other code is forgotten
+    g[0.5f] = Color4{ 0.0f, 1.0f, 0.0f, 1.0f };
+    CHECK(!Frame(editor, g, ImVec2(KeyX(0.5f), MarkerY), true, true));
+    CHECK(editor.GetSelected(&selected) && selected == 0.5f);
+    CHECK(g.erase(0.5f));
+    CHECK(!Frame(editor, g, ImVec2(), false, false));
+    CHECK(!editor.GetSelected(&selected));
+    CHECK(MatchesFullBake(editor, g));
+}
+
+int main()
+{
+    TestEditor();
+    return TEST_RESULT();
+}
@@ -0,0 +1,150 @@
+// Scalar evaluation, editing and change tracking of the gradient.h gradients and ImCandy::Gradient<N>
+#include "candy.h"
+#include "test.h"
+
+using namespace gradient;
+
+static bool Near(const Color4& a, const Color4& b, float eps = 1e-5f)
+{
+    return fabsf(a.r - b.r) <= eps && fabsf(a.g - b.g) <= eps && fabsf(a.b - b.b) <= eps && fabsf(a.a - b.a) <= eps;
+}
+
+template<typename G>
+static void TestEditing()
+{
+    G g;
+    g[0.0f] = Color4{ 1.0f, 0.0f, 0.0f, 1.0f };
+    g[1.0f] = Color4{ 0.0f, 0.0f, 1.0f, 1.0f };
+    CHECK(g.size() == 2);
+    CHECK(g.firstKey() == 0.0f && g.lastKey() == 1.0f);
+    CHECK(Near(g(0.25f), Color4{ 0.75f, 0.0f, 0.25f, 1.0f }));
+
+    // Outside the key range the end stops are returned
+    CHECK(Near(g(-1.0f), Color4{ 1.0f, 0.0f, 0.0f, 1.0f }));
+    CHECK(Near(g(2.0f), Color4{ 0.0f, 0.0f, 1.0f, 1.0f }));
+
+    g[0.5f] = Color4{ 0.0f, 1.0f, 0.0f, 1.0f };
+    CHECK(g.size() == 3);
+    CHECK(Near(g(0.75f), Color4{ 0.0f, 0.5f, 0.5f, 1.0f }));
+
+    CHECK(g.move(0.5f, 0.25f));
+    CHECK(Near(g(0.25f), Color4{ 0.0f, 1.0f, 0.0f, 1.0f }));
+    CHECK(g.erase(0.25f));
+    CHECK(!g.erase(0.25f));
+    CHECK(g.size() == 2);
+}
+
+template<typename G>
+static void TestChangeTracking()
+{
+    G g;
+    for (int i = 0; i <= 4; i++)
+        g[i * 0.25f] = Color4{ i * 0.25f, 0.0f, 0.0f, 1.0f };
+
+    const std::uint64_t version = g.version();
+    CHECK(g.changedSince(version).empty());
+
+    // Editing a stop with set() changes the segments on both sides of it
+    g.set(0.5f, Color4{ 1.0f, 1.0f, 1.0f, 1.0f });
+    const KeyRange<float> changed = g.changedSince(version);
+    CHECK(!changed.empty());
+    CHECK(changed.first == 0.25f && changed.last == 0.75f);
+    CHECK(g.changedSince(g.version()).empty());
+
+    // The non-const operator[] hands out a reference, so it counts as a change of everything
+    const std::uint64_t edited = g.version();
+    Color4& middle = g[0.5f];
+    middle.g = 0.0f;
+    const KeyRange<float> all = g.changedSince(edited);
+    CHECK(all.first == KeyRange<float>::all().first && all.last == KeyRange<float>::all().last);
+    CHECK(g[0.5f].g == 0.0f);
+
+    // set() adds a missing key point too
+    g.set(0.6f, Color4{ 0.0f, 1.0f, 0.0f, 1.0f });
+    CHECK(g.size() == 6);
+    CHECK(g.changedSince(g.version() - 1).first == 0.5f && g.changedSince(g.version() - 1).last == 0.75f);
+    CHECK(Near(static_cast<const G&>(g)[0.6f], Color4{ 0.0f, 1.0f, 0.0f, 1.0f }));
+
+    // Copies are other gradients for caches keyed on serial()
+    const G copy = g;
+    CHECK(copy.serial() != g.serial());
+    CHECK(copy.version() == g.version());
+}
+
+static void TestInterpolationPolicies()
+{
+    LinearGradient<Color4, float, CosineInterp> cosine;
+    cosine[0.0f] = Color4{ 0.0f, 0.0f, 0.0f, 1.0f };
+    cosine[1.0f] = Color4{ 1.0f, 1.0f, 1.0f, 1.0f };
+    CHECK_NEAR(cosine(0.5f).r, 0.5f, 1e-5f);
+    CHECK(cosine(0.25f).r < 0.25f);
+
+    LinearColor4Gradient dynamic;
+    dynamic[0.0f] = Color4{ 0.0f, 0.0f, 0.0f, 1.0f };
+    dynamic[1.0f] = Color4{ 1.0f, 1.0f, 1.0f, 1.0f };
+    dynamic.setInterpolation(smoothstep_interpolation<float>);
+    CHECK_NEAR(dynamic(0.25f).r, smoothstep_interpolation(0.25f), 1e-6f);
+}
+
+static void TestColorSpaceGradient()
+{
+    ColorSpaceGradient<FlatLinearColor4Gradient> oklab;
+    oklab[0.0f] = Color4{ 1.0f, 0.0f, 0.0f, 1.0f };
+    oklab.set(1.0f, Color4{ 0.0f, 1.0f, 0.0f, 1.0f });
+
+    // Stops read back in sRGB
+    const Color4 first = oklab[0.0f];
+    CHECK(Near(first, Color4{ 1.0f, 0.0f, 0.0f, 1.0f }, 1e-4f));
+    CHECK(Near(oklab(1.0f), Color4{ 0.0f, 1.0f, 0.0f, 1.0f }, 1e-4f));
+
+    // The red to green midpoint stays brighter than the muddy sRGB blend
+    const Color4 mid = oklab(0.5f);
+    CHECK(mid.r + mid.g > 1.0f);
+}
+
+static void TestCandyGradients()
+{
+    const ImCandy::Gradient<3> g = {{ ImVec4(1, 0, 0, 1), ImVec4(0, 1, 0, 1), ImVec4(0, 0, 1, 1) }};
+    CHECK_NEAR(g.Evaluate(0.5).x, 0.5f, 1e-6f);
+    CHECK_NEAR(g.Evaluate(1.5).z, 0.5f, 1e-6f);
+    CHECK_NEAR(g.Evaluate(5.0).z, 1.0f, 0.0f);
+
+    double ratio = 1.9;
+    g.Step(ratio, 0.2);
+    CHECK(ratio == 0.0);
+
+    // Perceptual Gradient2() without a PerceptualGradient matches one
+    const ImCandy::Gradient<3> cycle = {{ ImVec4(1, 0, 0, 1), ImVec4(0, 0, 1, 1), ImVec4(1, 0, 0, 1) }};
+    const ImCandy::PerceptualGradient<3> perceptual(cycle, gradient::ColorSpace::OKLab);
+    double a = 0.0, b = 0.0;
+    for (int i = 0; i < 300; i++)
+    {
+        const ImVec4 expected = perceptual.Step(a, 0.013);
+        const ImVec4 actual = ImCandy::Gradient2(ImVec4(1, 0, 0, 1), ImVec4(0, 0, 1, 1), b, 0.013, gradient::ColorSpace::OKLab);
+        CHECK(memcmp(&expected, &actual, sizeof(ImVec4)) == 0);
+    }
+
+    // The converted stops are cached per color pair and space: more pairs than cache entries still give the same colors
+    for (int round = 0; round < 2; round++)
+        for (int i = 0; i < 12; i++)
+        {
+            const ImVec4 col1(i / 12.0f, 0.5f, 1.0f - i / 12.0f, 1.0f), col2(1.0f, i / 24.0f, 0.25f, 1.0f);
+            const gradient::ColorSpace space = i % 2 ? gradient::ColorSpace::OKLab : gradient::ColorSpace::LinearSRGB;
+            const ImCandy::PerceptualGradient<3> expected({{ col1, col2, col1 }}, space);
+            double c = 0.7, d = 0.7;
+            const ImVec4 e = expected.Step(c, 0.1), f = ImCandy::Gradient2(col1, col2, d, 0.1, space);
+            CHECK(memcmp(&e, &f, sizeof(ImVec4)) == 0 && c == d);
+        }
+}
+
+int main()
+{
+    TestEditing<LinearColor4Gradient>();
+    TestEditing<FlatLinearColor4Gradient>();
+    TestChangeTracking<LinearColor4Gradient>();
+    TestChangeTracking<FlatLinearColor4Gradient>();
+    TestInterpolationPolicies();
+    TestColorSpaceGradient();
+    TestCandyGradients();
+    return TEST_RESULT();
+}
@@ -0,0 +1,163 @@
+// HSV / HSL conversions: batch (SIMD) against scalar, round-trip bounds, RainbowP() ramps and the HSL adjustments
+#include <random>
+#include <vector>
+#include "candy.h"
+#include "test.h"
+
+using namespace gradient;
+
+static int Channel(std::uint32_t c, int i) { return int((c >> (8 * i)) & 0xFF); }
+
+static void TestFixedPoint()
+{
+    // Every 13th RGB color, 13 is odd so all values of every channel show up, with varying alphas
+    std::vector<std::uint32_t> rgba;
+    for (std::uint32_t i = 0; i < (1u << 24); i += 13)
+        rgba.push_back(i | ((i / 13) & 0xFF) << 24);
+    const std::size_t count = rgba.size();
+
+    std::vector<HSV8> hsv(count);
+    std::vector<HSL8> hsl(count);
+    rgba8_to_hsv8(rgba.data(), count, hsv.data());
+    rgba8_to_hsl8(rgba.data(), count, hsl.data());
+    // Not in place: the alphas come from the source pixels, not from what the output held
+    std::vector<std::uint32_t> from_hsv(count, 0x80000000u), from_hsl(count, 0x80000000u);
+    hsv8_to_rgba8(hsv.data(), count, rgba.data(), from_hsv.data());
+    hsl8_to_rgba8(hsl.data(), count, rgba.data(), from_hsl.data());
+    std::vector<std::uint32_t> opaque_hsv(count), faded_hsl(count);
+    hsv8_to_rgba8(hsv.data(), count, opaque_hsv.data());
+    hsl8_to_rgba8(hsl.data(), count, faded_hsl.data(), 0x40);
+    std::uint32_t tail[7] = {};
+    hsv8_to_rgba8(hsv.data() + 1, 7, rgba.data() + 1, tail);
+    for (int i = 0; i < 7; i++)
+        CHECK(tail[i] == from_hsv[i + 1]);
+
+    int mismatches = 0, error_hsv = 0, error_hsl = 0;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        const HSV8 a = rgba8_to_hsv8(rgba[i]);
+        const HSL8 b = rgba8_to_hsl8(rgba[i]);
+        if (memcmp(&a, &hsv[i], sizeof(a)) != 0 || memcmp(&b, &hsl[i], sizeof(b)) != 0 || a.h >= hue8_steps || b.h >= hue8_steps)
+            mismatches++;
+        const std::uint8_t alpha = std::uint8_t(rgba[i] >> 24);
+        if (from_hsv[i] != hsv8_to_rgba8(hsv[i], alpha) || from_hsl[i] != hsl8_to_rgba8(hsl[i], alpha))
+            mismatches++;
+        if (opaque_hsv[i] != hsv8_to_rgba8(hsv[i]) || faded_hsl[i] != hsl8_to_rgba8(hsl[i], 0x40))
+            mismatches++;
+        for (int c = 0; c < 4; c++)
+        {
+            error_hsv = std::max(error_hsv, abs(Channel(from_hsv[i], c) - Channel(rgba[i], c)));
+            error_hsl = std::max(error_hsl, abs(Channel(from_hsl[i], c) - Channel(rgba[i], c)));
+        }
+    }
+    CHECK(mismatches == 0);
+    CHECK(error_hsv <= 1);
+    CHECK(error_hsl <= 2);
+}
+
+// At full saturation and value the hue wheel is the classic six-ramp rainbow of RainbowP()
+static void TestRainbow()
+{
+    int mismatches = 0;
+    for (int n = 0; n < hue8_steps; n++)
+    {
+        const int x = n % 256;
+        const int ramps[6][3] = { { 255, x, 0 }, { 255 - x, 255, 0 }, { 0, 255, x }, { 0, 255 - x, 255 }, { x, 0, 255 }, { 255, 0, 255 - x } };
+        const int* rgb = ramps[n / 256];
+        const std::uint32_t expected = std::uint32_t(rgb[0]) | std::uint32_t(rgb[1]) << 8 | std::uint32_t(rgb[2]) << 16 | 0xFF000000u;
+        if (hsv8_to_rgba8(HSV8{ std::uint16_t(n), 255, 255 }) != expected)
+            mismatches++;
+    }
+    CHECK(mismatches == 0);
+
+    ImCandy::RainbowState state;
+    const ImVec4 red = ImCandy::RainbowP(state, 1.0 / 6.0);
+    const ImVec4 yellow = ImCandy::RainbowP(state, 0.0);
+    CHECK(red.x == 1.0f && red.y == 0.0f && red.z == 0.0f);
+    CHECK(yellow.x == 1.0f && yellow.y == 1.0f && yellow.z == 0.0f);
+}
+
+static void TestFloat()
+{
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    const std::size_t count = 1 << 16;
+    std::vector<float> rgba(4 * count), hsv(4 * count), hsl(4 * count), from_hsv(4 * count), from_hsl(4 * count);
+    for (float& v : rgba)
+        v = unit(rng);
+    // Grays and ties between the max channels
+    for (std::size_t i = 0; i < 64; i++)
+        rgba[4 * i] = rgba[4 * i + 1] = rgba[4 * i + 2] = float(i % 3) * 0.5f;
+    for (std::size_t i = 64; i < 128; i++)
+        rgba[4 * i + 1] = rgba[4 * i];
+
+    rgb_to_hsv(rgba.data(), count, hsv.data());
+    hsv_to_rgb(hsv.data(), count, from_hsv.data());
+    rgb_to_hsl(rgba.data(), count, hsl.data());
+    hsl_to_rgb(hsl.data(), count, from_hsl.data());
+
+    int mismatches = 0;
+    float error = 0.0f;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        const Color4 c = { rgba[4 * i], rgba[4 * i + 1], rgba[4 * i + 2], rgba[4 * i + 3] };
+        const Color4 a = rgb_to_hsv(c), b = rgb_to_hsl(c);
+        const Color4 ra = hsv_to_rgb(a), rb = hsl_to_rgb(b);
+        for (int k = 0; k < 4; k++)
+        {
+            if (a[k] != hsv[4 * i + k] || b[k] != hsl[4 * i + k] || ra[k] != from_hsv[4 * i + k] || rb[k] != from_hsl[4 * i + k])
+                mismatches++;
+            error = std::max(error, std::max(fabsf(ra[k] - c[k]), fabsf(rb[k] - c[k])));
+        }
+    }
+    CHECK(mismatches == 0);
+    CHECK(error < 1e-5f);
+}
+
+// The fixed-point adjustment tracks the float one, in place or not
+static void TestAdjust()
+{
+    std::mt19937 rng(2);
+    const std::size_t count = 4096;
+    std::vector<std::uint32_t> packed(count), packed_out(count);
+    std::vector<float> rgba(4 * count), rgba_out(4 * count);
+    for (std::size_t i = 0; i < count; i++)
+    {
+        packed[i] = std::uint32_t(rng());
+        for (int c = 0; c < 4; c++)
+            rgba[4 * i + c] = Channel(packed[i], c) / 255.0f;
+    }
+
+    const float params[][3] = { { 0.0f, 1.0f, 0.0f }, { 0.25f, 1.0f, 0.0f }, { 0.1f, 0.5f, 0.1f }, { -0.3f, 1.5f, -0.2f }, { 3.7f, 0.0f, 0.0f } };
+    for (const float* p : params)
+    {
+        adjust_hsl(rgba.data(), count, p[0], p[1], p[2], rgba_out.data());
+        adjust_hsl(packed.data(), count, p[0], p[1], p[2], packed_out.data());
+        int error = 0;
+        for (std::size_t i = 0; i < count; i++)
+            for (int c = 0; c < 4; c++)
+                error = std::max(error, abs(Channel(packed_out[i], c) - int(rgba_out[4 * i + c] * 255.0f + 0.5f)));
+        CHECK(error <= 3);
+
+        std::vector<std::uint32_t> in_place = packed;
+        adjust_hsl(in_place.data(), count, p[0], p[1], p[2], in_place.data());
+        CHECK(in_place == packed_out);
+    }
+
+    // A full turn is the identity up to rounding, a zero saturation gives grays
+    hue_rotate(rgba.data(), count, 1.0f, rgba_out.data());
+    for (std::size_t i = 0; i < 4 * count; i++)
+        CHECK_NEAR(rgba_out[i], rgba[i], 1e-5f);
+    saturate(packed.data(), count, 0.0f, packed_out.data());
+    for (std::size_t i = 0; i < count; i++)
+        CHECK(Channel(packed_out[i], 0) == Channel(packed_out[i], 1) && Channel(packed_out[i], 1) == Channel(packed_out[i], 2));
+}
+
+int main()
+{
+    TestFixedPoint();
+    TestRainbow();
+    TestFloat();
+    TestAdjust();
+    return TEST_RESULT();
+}
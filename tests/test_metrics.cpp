@@ -0,0 +1,114 @@
+// IMCANDY_ENABLE_METRICS counters: per-frame totals, hits, allocations, histories and the metrics window
+#include "candy.h"
+#include "test.h"
+
+using namespace gradient;
+
+static void TestCounters()
+{
+    ImCandy::Metrics& metrics = ImCandy::GetMetrics();
+    metrics.Reset();
+
+    double ratio = 0.0;
+    ImCandy::Rainbow(ratio);
+    ImCandy::RainbowU32(ratio);
+
+    // The second lookup of an id in a frame is a cache hit
+    StubNewFrame(0.016f);
+    ImCandy::Animator animator;
+    animator.Rainbow(1);
+    animator.Rainbow(1);
+    animator.Rainbow(2);
+
+    FlatLinearColor4Gradient g;
+    g[0.0f] = Color4{ 1.0f, 0.0f, 0.0f, 1.0f };
+    g[1.0f] = Color4{ 0.0f, 0.0f, 1.0f, 1.0f };
+    float points[100];
+    std::uint32_t packed[100];
+    for (int i = 0; i < 100; i++)
+        points[i] = i / 99.0f;
+    g.evaluate(points, 100, packed);
+
+    // A valarray color allocates on every evaluation
+    LinearColorGradient dynamic;
+    dynamic[0.0f] = Color{ 0.0, 0.0, 0.0, 255.0 };
+    dynamic[1.0f] = Color{ 255.0, 255.0, 255.0, 255.0 };
+    dynamic(0.5f);
+    dynamic(0.25f);
+
+    // Nothing is visible until the frame ends
+    CHECK(metrics.GetFrame(ImCandy::MetricsCounter_Rainbow).Calls == 0);
+    metrics.NextFrame();
+
+    const ImCandy::MetricsStats& rainbow = metrics.GetFrame(ImCandy::MetricsCounter_Rainbow);
+    CHECK(rainbow.Calls == 2 && rainbow.Hits == 1);
+    const ImCandy::MetricsStats& anim = metrics.GetFrame(ImCandy::MetricsCounter_Animator);
+    CHECK(anim.Calls == 3 && anim.Hits == 1);
+    const ImCandy::MetricsStats& batch = metrics.GetFrame(ImCandy::MetricsCounter_GradientBatch);
+    CHECK(batch.Calls == 1 && batch.Items == 100);
+    const ImCandy::MetricsStats& eval = metrics.GetFrame(ImCandy::MetricsCounter_GradientEval);
+    CHECK(eval.Calls == 2 && eval.Allocations == 2);
+    CHECK(metrics.GetFrame(ImCandy::MetricsCounter_Bake).Calls == 0);
+    CHECK(batch.Milliseconds >= 0.0);
+
+    // The histories hold one entry per frame
+    const int offset = metrics.GetHistoryOffset();
+    CHECK(offset == 1);
+    CHECK(metrics.GetHistoryItems(ImCandy::MetricsCounter_GradientBatch)[offset - 1] == 100.0f);
+
+    // The next frame starts from zero
+    metrics.NextFrame();
+    CHECK(metrics.GetFrame(ImCandy::MetricsCounter_Rainbow).Calls == 0);
+    CHECK(metrics.GetHistoryOffset() == 2);
+
+    metrics.Reset();
+    CHECK(metrics.GetHistoryOffset() == 0);
+    CHECK(metrics.GetHistoryItems(ImCandy::MetricsCounter_GradientBatch)[0] == 0.0f);
+}
+
+static void TestBake()
+{
+    ImCandy::Metrics& metrics = ImCandy::GetMetrics();
+    metrics.Reset();
+
+    // A bake allocates its table only, update() re-samples in place
+    LinearGradient<Color4, float> g;
+    g[0.0f] = Color4{ 1.0f, 0.0f, 0.0f, 1.0f };
+    g[0.5f] = Color4{ 0.0f, 1.0f, 0.0f, 1.0f };
+    g[1.0f] = Color4{ 0.0f, 0.0f, 1.0f, 1.0f };
+    BakedGradient<float> baked(g, 1024);
+    g.set(1.0f, Color4{ 1.0f, 1.0f, 1.0f, 1.0f });
+    const std::size_t updated = baked.update(g);
+    CHECK(updated > 0 && updated < 1024);
+    metrics.NextFrame();
+
+    const ImCandy::MetricsStats& bake = metrics.GetFrame(ImCandy::MetricsCounter_Bake);
+    CHECK(bake.Calls == 2 && bake.Items == 1024 + updated);
+    CHECK(bake.Allocations == 1);
+}
+
+static void TestWindow()
+{
+    ImCandy::Metrics& metrics = ImCandy::GetMetrics();
+    metrics.Reset();
+
+    // The window ends the frame of the counters once per ImGui frame
+    StubNewFrame(0.016f);
+    ImCandy::ApplyTheme(ImCandy::MakeTheme_Nord(), NULL);
+    ImCandy::ShowMetricsWindow();
+    CHECK(metrics.GetFrame(ImCandy::MetricsCounter_ApplyTheme).Calls == 1);
+    ImCandy::ShowMetricsWindow();
+    CHECK(metrics.GetFrame(ImCandy::MetricsCounter_ApplyTheme).Calls == 1);
+    CHECK(metrics.GetHistoryOffset() == 1);
+
+    for (int i = 0; i < ImCandy::MetricsCounter_COUNT; i++)
+        CHECK(ImCandy::Metrics::GetName(ImCandy::MetricsCounter(i)) != NULL);
+}
+
+int main()
+{
+    TestCounters();
+    TestBake();
+    TestWindow();
+    return TEST_RESULT();
+}
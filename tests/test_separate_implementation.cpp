@@ -0,0 +1,23 @@
+// IMCANDY_SEPARATE_IMPLEMENTATION: the functions are compiled once (separate_impl.cpp) and the shared
+// instances are the same objects in every translation unit
+#include "candy.h"
+#include "parallel.h"
+#include "themefile.h"
+#include "test.h"
+
+ImCandy::Animator* OtherAnimator();
+ImCandy::StyleBindings* OtherBindings();
+ImVec4 OtherRainbow(double ratio);
+
+int main()
+{
+    CHECK(OtherAnimator() == &ImCandy::GetAnimator());
+    CHECK(OtherBindings() == &ImCandy::GetStyleBindings());
+    CHECK(ImCandy::GetThemeRegistry().GetCount() == 4);
+
+    double ratio = 0.5;
+    const ImVec4 here = ImCandy::Rainbow(ratio);
+    const ImVec4 there = OtherRainbow(0.5);
+    CHECK(memcmp(&here, &there, sizeof(ImVec4)) == 0);
+    return TEST_RESULT();
+}
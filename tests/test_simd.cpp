@@ -0,0 +1,135 @@
+// Batch evaluation (SIMD kernels, or their scalar fallback with GRADIENT_DISABLE_SIMD) against operator()
+#include <array>
+#include <vector>
+#include "candy.h"
+#include "parallel.h"
+#include "test.h"
+
+using namespace gradient;
+
+// Packing of one channel as documented for the packed evaluate()
+static std::uint32_t PackReference(const Color4& c)
+{
+    std::uint32_t packed = 0;
+    for (int i = 0; i < 4; i++)
+        packed |= std::uint32_t(std::min(std::max(c[i] * 255.0f + 0.5f, 0.0f), 255.0f)) << (8 * i);
+    return packed;
+}
+
+static bool PackedNear(std::uint32_t a, std::uint32_t b)
+{
+    for (int i = 0; i < 32; i += 8)
+        if (abs(int((a >> i) & 0xFF) - int((b >> i) & 0xFF)) > 1)
+            return false;
+    return true;
+}
+
+// Every count up to a few SIMD widths past the block size, points slightly outside the key range included.
+// reference gives the expected colors, g itself when it has an operator().
+template<typename G, typename Reference>
+static void CheckBatch(const G& g, const Reference& reference, const char* name)
+{
+    const int max_count = int(detail::batch_block) + 37;
+    std::vector<float> points(max_count), rgba(4 * max_count), rgba_scratch(4 * max_count);
+    std::vector<std::uint32_t> packed(max_count), packed_scratch(max_count);
+    BatchScratch<float> scratch;
+
+    int failures = 0;
+    for (int count = 0; count <= max_count; count += count < 40 ? 1 : 29)
+    {
+        for (int i = 0; i < count; i++)
+            points[i] = -0.05f + 1.1f * float(i) / float(std::max(count - 1, 1));
+
+        g.evaluate(points.data(), count, rgba.data());
+        g.evaluate(points.data(), count, packed.data());
+        g.evaluate(points.data(), count, rgba_scratch.data(), scratch);
+        g.evaluate(points.data(), count, packed_scratch.data(), scratch);
+        for (int i = 0; i < count; i++)
+        {
+            const Color4 expected = reference(points[i]);
+            for (int c = 0; c < 4; c++)
+                if (fabsf(rgba[4 * i + c] - expected[c]) > 1e-5f || rgba_scratch[4 * i + c] != rgba[4 * i + c])
+                    failures++;
+            if (!PackedNear(packed[i], PackReference(expected)) || packed_scratch[i] != packed[i])
+                failures++;
+        }
+    }
+    if (failures)
+        fprintf(stderr, "%s: %d mismatches\n", name, failures);
+    CHECK(failures == 0);
+}
+
+template<typename G>
+static void Fill(G& g, int stops)
+{
+    for (int i = 0; i < stops; i++)
+    {
+        const float k = float(i) / float(stops - 1);
+        g[k * k] = Color4{ k, 1.0f - k, fmodf(k * 7.0f, 1.0f), 0.5f + 0.5f * k };
+    }
+}
+
+static void TestLayouts()
+{
+    // Below and above the stops kept inline by the flattening
+    for (int stops = 2; stops <= 40; stops += 19)
+    {
+        LinearColor4Gradient linear;
+        FlatLinearColor4Gradient flat;
+        LinearGradient<Color4, float, CosineInterp> cosine;
+        FlatLinearGradient<Color4, float, SmoothstepInterp> smooth;
+        Fill(linear, stops);
+        Fill(flat, stops);
+        Fill(cosine, stops);
+        Fill(smooth, stops);
+        CheckBatch(linear, linear, "LinearColor4Gradient");
+        CheckBatch(flat, flat, "FlatLinearColor4Gradient");
+        CheckBatch(cosine, cosine, "LinearGradient<CosineInterp>");
+        CheckBatch(smooth, smooth, "FlatLinearGradient<SmoothstepInterp>");
+        CheckBatch(GradientSnapshot<float>(smooth), smooth, "GradientSnapshot");
+    }
+}
+
+// The scratch notices edits through version() and other gradients through serial()
+static void TestScratchInvalidation()
+{
+    LinearColor4Gradient a, b;
+    Fill(a, 5);
+    Fill(b, 5);
+    b[0.5f] = Color4{ 1.0f, 1.0f, 1.0f, 1.0f };
+
+    BatchScratch<float> scratch;
+    const float point = 0.5f;
+    float rgba[4];
+    a.evaluate(&point, 1, rgba, scratch);
+    a[0.5f] = Color4{ 0.0f, 0.0f, 0.0f, 1.0f };
+    a.evaluate(&point, 1, rgba, scratch);
+    CHECK(rgba[0] == 0.0f);
+    b.evaluate(&point, 1, rgba, scratch);
+    CHECK(rgba[0] == 1.0f);
+}
+
+static void TestParallel()
+{
+    FlatLinearColor4Gradient g;
+    Fill(g, 7);
+    const GradientSnapshot<float> snapshot(g);
+
+    std::vector<float> points(100000);
+    for (size_t i = 0; i < points.size(); i++)
+        points[i] = float(i) / float(points.size() - 1);
+    std::vector<ImU32> serial(points.size()), parallel(points.size());
+
+    snapshot.evaluate(points.data(), points.size(), serial.data());
+    ImCandy::ThreadPool pool(3);
+    ImCandy::ColorizeParallel(pool, snapshot, points.data(), points.size(), parallel.data(), 4096);
+    CHECK(serial == parallel);
+}
+
+int main()
+{
+    TestLayouts();
+    TestScratchInvalidation();
+    TestParallel();
+    return TEST_RESULT();
+}
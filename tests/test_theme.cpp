@@ -0,0 +1,149 @@
+// Theme registry: snapshots, lookup by name and id, per-context themes. StyleTransition cross-fades.
+#include "candy.h"
+#include "test.h"
+
+static bool SameColors(const ImGuiStyle& a, const ImGuiStyle& b)
+{
+    return memcmp(a.Colors, b.Colors, sizeof(a.Colors)) == 0;
+}
+
+static void TestRegistry()
+{
+    ImCandy::ThemeRegistry themes;
+    CHECK(themes.GetCount() == 0);
+    CHECK(themes.FindID("Nord") == 0);
+    CHECK(!themes.Apply("Nord"));
+
+    // A snapshot holds the theme applied on top of the base style
+    ImGuiStyle base;
+    base.FrameRounding = 7.0f;
+    const ImGuiID nord = themes.Register("Nord", ImCandy::MakeTheme_Nord(), &base);
+    CHECK(nord == ImCandy::ThemeRegistry::HashName("Nord"));
+    CHECK(themes.FindID("Nord") == nord);
+    CHECK(themes.GetCount() == 1 && strcmp(themes.GetName(0), "Nord") == 0 && themes.GetID(0) == nord);
+
+    ImGuiStyle expected = base;
+    ImCandy::ApplyTheme(ImCandy::MakeTheme_Nord(), &expected);
+    const ImGuiStyle* snapshot = themes.Find("Nord");
+    CHECK(snapshot != NULL && SameColors(*snapshot, expected));
+    CHECK(snapshot->FrameRounding == expected.FrameRounding);
+
+    ImGuiStyle style;
+    CHECK(themes.Apply(nord, &style));
+    CHECK(SameColors(style, expected));
+
+    // Registering a name again replaces its snapshot, ids stay sorted
+    themes.Register("Blender", ImCandy::MakeTheme_Blender());
+    themes.Register("Cyberpunk", ImCandy::MakeTheme_Cyberpunk());
+    ImGuiStyle plain;
+    plain.Colors[ImGuiCol_Text] = ImVec4(0.5f, 0.5f, 0.5f, 1.0f);
+    CHECK(themes.Register("Nord", plain) == nord);
+    CHECK(themes.GetCount() == 3);
+    CHECK(themes.Find(nord)->Colors[ImGuiCol_Text].x == 0.5f);
+    for (int i = 1; i < themes.GetCount(); i++)
+        CHECK(themes.GetID(i - 1) < themes.GetID(i));
+}
+
+static void TestContextThemes()
+{
+    ImCandy::ThemeRegistry themes;
+    const ImGuiID blender = themes.Register("Blender", ImCandy::MakeTheme_Blender());
+    const ImGuiID nord = themes.Register("Nord", ImCandy::MakeTheme_Nord());
+    ImGuiContext* ctx = ImGui::GetCurrentContext();
+    ImGuiContext* other = (ImGuiContext*)&themes;
+
+    // Nothing to apply without a default or an override
+    CHECK(themes.GetContextTheme(ctx) == 0);
+    CHECK(!themes.ApplyContextTheme());
+
+    themes.SetDefaultTheme(blender);
+    themes.SetContextTheme(other, nord);
+    CHECK(themes.GetContextTheme(ctx) == blender);
+    CHECK(themes.GetContextTheme(other) == nord);
+
+    // Copies once, then only when the theme or the registry changed
+    CHECK(themes.ApplyContextTheme());
+    CHECK(SameColors(ImGui::GetStyle(), *themes.Find(blender)));
+    CHECK(!themes.ApplyContextTheme());
+    CHECK(themes.ApplyContextTheme(true));
+
+    themes.SetContextTheme(ctx, nord);
+    CHECK(themes.ApplyContextTheme());
+    CHECK(SameColors(ImGui::GetStyle(), *themes.Find(nord)));
+    themes.Register("Nord", ImCandy::MakeTheme_Cyberpunk());
+    CHECK(themes.ApplyContextTheme());
+
+    // 0 removes the override, RemoveContext() forgets the context
+    themes.SetContextTheme(ctx, 0);
+    CHECK(themes.GetContextTheme(ctx) == blender);
+    themes.RemoveContext(other);
+    CHECK(themes.GetContextTheme(other) == blender);
+}
+
+static void TestBuiltinRegistry()
+{
+    ImCandy::ThemeRegistry& themes = ImCandy::GetThemeRegistry();
+    const char* names[] = { "Dark", "Blender", "Cyberpunk", "Nord" };
+    for (int i = 0; i < IM_ARRAYSIZE(names); i++)
+        CHECK(themes.Find(names[i]) != NULL);
+}
+
+static void TestTransition()
+{
+    ImGuiStyle from, to, style;
+    for (int i = 0; i < ImGuiCol_COUNT; i++)
+    {
+        from.Colors[i] = ImVec4(0.0f, 0.0f, 0.0f, 1.0f);
+        to.Colors[i] = ImVec4(1.0f, 0.5f, float(i) / ImGuiCol_COUNT, 0.0f);
+    }
+    from.FrameRounding = 0.0f;
+    to.FrameRounding = 8.0f;
+    from.ItemSpacing = ImVec2(0.0f, 0.0f);
+    to.ItemSpacing = ImVec2(10.0f, 4.0f);
+    to.AntiAliasedFill = !from.AntiAliasedFill;
+
+    ImCandy::StyleTransition fade;
+    CHECK(!fade.IsActive() && fade.GetProgress() == 1.0f);
+    CHECK(!fade.Update(&style));
+
+    // Halfway through, smoothstep is at one half on every color and blended field
+    fade.Start(to, 1.0f, &from);
+    CHECK(fade.IsActive());
+    StubNewFrame(0.5f);
+    CHECK(fade.Update(&style));
+    CHECK_NEAR(fade.GetProgress(), 0.5f, 1e-6f);
+    for (int i = 0; i < ImGuiCol_COUNT; i++)
+    {
+        CHECK_NEAR(style.Colors[i].x, 0.5f, 1e-6f);
+        CHECK_NEAR(style.Colors[i].z, 0.5f * to.Colors[i].z, 1e-6f);
+        CHECK_NEAR(style.Colors[i].w, 0.5f, 1e-6f);
+    }
+    CHECK_NEAR(style.FrameRounding, 4.0f, 1e-6f);
+    CHECK_NEAR(style.ItemSpacing.x, 5.0f, 1e-6f);
+    CHECK_NEAR(style.ItemSpacing.y, 2.0f, 1e-6f);
+
+    // Fields that are not blended switch at the start
+    CHECK(style.AntiAliasedFill == to.AntiAliasedFill);
+
+    // The last update writes the target exactly and ends the fade
+    StubNewFrame(0.75f);
+    CHECK(fade.Update(&style));
+    CHECK(!fade.IsActive());
+    CHECK(SameColors(style, to) && style.FrameRounding == 8.0f && style.ItemSpacing.x == 10.0f);
+    CHECK(!fade.Update(&style));
+
+    // Finish() jumps to the target, the current style by default
+    fade.Start(from, 1.0f, &to);
+    fade.Finish();
+    CHECK(!fade.IsActive());
+    CHECK(SameColors(ImGui::GetStyle(), from));
+}
+
+int main()
+{
+    TestRegistry();
+    TestContextThemes();
+    TestBuiltinRegistry();
+    TestTransition();
+    return TEST_RESULT();
+}
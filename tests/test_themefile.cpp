@@ -0,0 +1,109 @@
+// Theme files: text and binary parsing, save/load round trip and the watcher's initial load
+#include <string>
+#include "themefile.h"
+#include "test.h"
+
+static const char* const TextTheme =
+    "# Nord\n"
+    "; another comment\n"
+    "\n"
+    "WindowBg          #2e3440\n"
+    "Border            #4c566a80\n"
+    "Text              0.9 0.9 0.9\n"
+    "FrameRounding     3\n"
+    "FramePadding      6 4\n"
+    "SomeFutureField   1\n";
+
+static void TestText()
+{
+    ImGuiStyle style;
+    int error_line = -1;
+    CHECK(ImCandy::ParseTheme(TextTheme, strlen(TextTheme), &style, &error_line));
+    CHECK_NEAR(style.Colors[ImGuiCol_WindowBg].x, 0x2e / 255.0f, 1e-6f);
+    CHECK_NEAR(style.Colors[ImGuiCol_WindowBg].w, 1.0f, 0.0f);
+    CHECK_NEAR(style.Colors[ImGuiCol_Border].w, 0x80 / 255.0f, 1e-6f);
+    CHECK_NEAR(style.Colors[ImGuiCol_Text].y, 0.9f, 1e-6f);
+    CHECK_NEAR(style.Colors[ImGuiCol_Text].w, 1.0f, 0.0f);
+    CHECK(style.FrameRounding == 3.0f);
+    CHECK(style.FramePadding.x == 6.0f && style.FramePadding.y == 4.0f);
+
+    // Lines are counted from 1
+    const char* broken = "WindowBg #2e3440\nFrameRounding three\n";
+    CHECK(!ImCandy::ParseTheme(broken, strlen(broken), &style, &error_line));
+    CHECK(error_line == 2);
+    const char* bad_color = "WindowBg #2e34\n";
+    CHECK(!ImCandy::ParseTheme(bad_color, strlen(bad_color), &style, &error_line));
+    CHECK(error_line == 1);
+}
+
+static std::string TempPath(const char* name)
+{
+    const char* dir = getenv("TMPDIR");
+    return std::string(dir ? dir : "/tmp") + "/imcandy_test_" + name;
+}
+
+static void TestRoundTrip()
+{
+    ImGuiStyle saved;
+    saved.Colors[ImGuiCol_Button] = ImVec4(0.2f, 0.4f, 0.6f, 0.8f);
+    saved.FrameRounding = 5.0f;
+    saved.ItemSpacing = ImVec2(3.0f, 7.0f);
+
+    for (int binary = 0; binary < 2; binary++)
+    {
+        const std::string path = TempPath(binary ? "theme.bin" : "theme.txt");
+        CHECK(ImCandy::SaveThemeFile(path.c_str(), saved, binary != 0));
+
+        ImGuiStyle loaded;
+        for (int i = 0; i < ImGuiCol_COUNT; i++)
+            loaded.Colors[i] = ImVec4();
+        CHECK(ImCandy::LoadThemeFile(path.c_str(), &loaded));
+        for (int i = 0; i < ImGuiCol_COUNT; i++)
+            for (int c = 0; c < 4; c++)
+                CHECK_NEAR((&loaded.Colors[i].x)[c], (&saved.Colors[i].x)[c], 0.5f / 255.0f + 1e-6f);
+        CHECK(loaded.FrameRounding == 5.0f);
+        CHECK(loaded.ItemSpacing.x == 3.0f && loaded.ItemSpacing.y == 7.0f);
+        remove(path.c_str());
+    }
+
+    // A truncated binary theme is rejected
+    const char header[] = { 'I', 'C', 'T', 'H', 1, 0, 0, 0, 9, 0, 0, 0 };
+    ImGuiStyle style;
+    CHECK(!ImCandy::ParseTheme(header, sizeof(header), &style));
+}
+
+static void TestWatcherStart()
+{
+    ImCandy::ThemeWatcher watcher;
+    CHECK(!watcher.Start(TempPath("missing.theme").c_str()));
+    CHECK(watcher.GetErrorLine() == -1);
+    watcher.Stop();
+
+    const std::string path = TempPath("watched.theme");
+    FILE* f = fopen(path.c_str(), "w");
+    fputs(TextTheme, f);
+    fclose(f);
+    CHECK(watcher.Start(path.c_str()));
+    CHECK(watcher.GetErrorLine() == 0);
+    ImGuiStyle style;
+    CHECK(watcher.ApplyIfChanged(&style));
+    CHECK(style.FrameRounding == 3.0f);
+    CHECK(!watcher.ApplyIfChanged(&style));
+    watcher.Stop();
+
+    // Files larger than MaxFileSize are not loaded
+    watcher.MaxFileSize = 16;
+    CHECK(!watcher.Start(path.c_str()));
+    CHECK(watcher.GetErrorLine() == -1);
+    CHECK(!watcher.ApplyIfChanged(&style));
+    watcher.Stop();
+    remove(path.c_str());
+}
+
+int main()
+{
+    TestText();
+    TestRoundTrip();
+    TestWatcherStart();
+    return TEST_RESULT();
+}